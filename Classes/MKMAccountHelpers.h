@@ -122,13 +122,16 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (instancetype)sharedInstance;
 
-@property (strong, nonatomic, nullable) id<MKMAddressHelper> addressHelper;
+// atomic: safe to replace while other threads are parsing;
+// to register address/meta/document factories at runtime too, keep
+// them in 'MKFactoryRegistry' snapshots inside the helpers
+@property (strong, nullable) id<MKMAddressHelper> addressHelper;
 
-@property (strong, nonatomic, nullable) id<MKMIDHelper> idHelper;
+@property (strong, nullable) id<MKMIDHelper> idHelper;
 
-@property (strong, nonatomic, nullable) id<MKMMetaHelper> metaHelper;
+@property (strong, nullable) id<MKMMetaHelper> metaHelper;
 
-@property (strong, nonatomic, nullable) id<MKMDocumentHelper> docHelper;
+@property (strong, nullable) id<MKMDocumentHelper> docHelper;
 
 @end
 
@@ -128,6 +128,16 @@ _Nullable id<MKMID> MKMIDParse(_Nullable id identifier);
 
 NSMutableArray<id<MKMID>> *MKMIDConvert(NSArray<id> *array);
 
+/**
+ *  Parse IDs one by one from elements enumerator
+ *  (e.g. MKJSONArrayReader), without materializing the whole array
+ *
+ * @param elements - ID string enumerator
+ * @param block    - handler for each ID parsed
+ */
+void MKMIDEnumerate(NSEnumerator<id> *elements,
+                    void (NS_NOESCAPE ^block)(id<MKMID> did, BOOL *stop));
+
 NSMutableArray<NSString *> *MKMIDRevert(NSArray<id<MKMID>> *identifiers);
 
 #ifdef __cplusplus
@@ -84,6 +84,19 @@ NSMutableArray<id<MKMID>> *MKMIDConvert(NSArray<id> *array) {
     return members;
 }
 
+void MKMIDEnumerate(NSEnumerator<id> *elements,
+                    void (NS_NOESCAPE ^block)(id<MKMID> did, BOOL *stop)) {
+    BOOL stop = NO;
+    id<MKMID> did;
+    id obj;
+    while (!stop && (obj = [elements nextObject])) {
+        did = MKMIDParse(obj);
+        if (did) {
+            block(did, &stop);
+        }
+    }
+}
+
 NSMutableArray<NSString *> *MKMIDRevert(NSArray<id<MKMID>> *identifiers) {
     NSMutableArray<NSString *> *array;
     array = [[NSMutableArray alloc] initWithCapacity:identifiers.count];
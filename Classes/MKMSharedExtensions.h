@@ -64,11 +64,20 @@ extern "C" {
 NSData *MKMakePromise(void); // 'Moky loves May Lee forever!'
 
 // verify with signature
+// (results are memoized by digest of both keys' data,
+//  only when a SHA-256 digester is set)
 BOOL MKMatchAsymmetricKeys(id<MKSignKey> sKey, id<MKVerifyKey> pKey);
 
 // check by encryption
+// (same algorithm: constant-time comparison of key data, nothing encrypted;
+//  otherwise memoized by digest of both keys' data, only when a SHA-256
+//  digester is set; it still allocates: the memo key costs a buffer and
+//  a digest per call)
 BOOL MKMatchSymmetricKeys(id<MKEncryptKey> encKey, id<MKDecryptKey> decKey);
 
+// forget memoized match results of both (e.g. after keys replaced)
+void MKMatchKeysClearCache(void);
+
 #ifdef __cplusplus
 } /* end of extern "C" */
 #endif
@@ -89,16 +98,18 @@ BOOL MKMatchSymmetricKeys(id<MKEncryptKey> encKey, id<MKDecryptKey> decKey);
 
 #pragma mark CryptographyKey FactoryManager
 
+// facades of the extension managers, same atomic properties
+// (factory maps inside the helpers: see 'MKFactoryRegistry')
 @interface MKSharedCryptoExtensions : NSObject
 
 + (instancetype)sharedInstance;
 
-@property (strong, nonatomic, nullable) id<MKSymmetricKeyHelper> symmetricHelper;
+@property (strong, nullable) id<MKSymmetricKeyHelper> symmetricHelper;
 
-@property (strong, nonatomic, nullable) id<MKPrivateKeyHelper> privateHelper;
-@property (strong, nonatomic, nullable) id<MKPublicKeyHelper> publicHelper;
+@property (strong, nullable) id<MKPrivateKeyHelper> privateHelper;
+@property (strong, nullable) id<MKPublicKeyHelper> publicHelper;
 
-@property (strong, nonatomic, nullable) id<MKGeneralCryptoHelper> helper;
+@property (strong, nullable) id<MKGeneralCryptoHelper> helper;
 
 @end
 
@@ -124,11 +135,11 @@ BOOL MKMatchSymmetricKeys(id<MKEncryptKey> encKey, id<MKDecryptKey> decKey);
 
 + (instancetype)sharedInstance;
 
-@property (strong, nonatomic, nullable) id<MKTransportableDataHelper> tedHelper;
+@property (strong, nullable) id<MKTransportableDataHelper> tedHelper;
 
-@property (strong, nonatomic, nullable) id<MKPortableNetworkFileHelper> pnfHelper;
+@property (strong, nullable) id<MKPortableNetworkFileHelper> pnfHelper;
 
-@property (strong, nonatomic, nullable) id<MKGeneralFormatHelper> helper;
+@property (strong, nullable) id<MKGeneralFormatHelper> helper;
 
 @end
 
@@ -158,12 +169,12 @@ BOOL MKMatchSymmetricKeys(id<MKEncryptKey> encKey, id<MKDecryptKey> decKey);
 
 + (instancetype)sharedInstance;
 
-@property (strong, nonatomic, nullable) id<MKMAddressHelper> addressHelper;
-@property (strong, nonatomic, nullable) id<MKMIDHelper> idHelper;
-@property (strong, nonatomic, nullable) id<MKMMetaHelper> metaHelper;
-@property (strong, nonatomic, nullable) id<MKMDocumentHelper> docHelper;
+@property (strong, nullable) id<MKMAddressHelper> addressHelper;
+@property (strong, nullable) id<MKMIDHelper> idHelper;
+@property (strong, nullable) id<MKMMetaHelper> metaHelper;
+@property (strong, nullable) id<MKMDocumentHelper> docHelper;
 
-@property (strong, nonatomic, nullable) id<MKMGeneralAccountHelper> helper;
+@property (strong, nullable) id<MKMGeneralAccountHelper> helper;
 
 @end
 
@@ -37,7 +37,10 @@
 
 #import "MKAsymmetricKey.h"
 #import "MKCryptoHelpers.h"
+#import "MKDataParser.h"
+#import "MKDigester.h"
 #import "MKFormatHelpers.h"
+#import "MKLRUCache.h"
 #import "MKMAccountHelpers.h"
 
 #import "MKMSharedExtensions.h"
@@ -53,18 +56,116 @@ NSData *MKMakePromise(void) {
     return promise;
 }
 
+// match results, keyed by digest of both keys
+static MKLRUCache<NSData *, NSNumber *> *match_cache(void) {
+    static MKLRUCache *s_cache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        s_cache = [[MKLRUCache alloc] initWithCountLimit:256];
+    });
+    return s_cache;
+}
+
+static inline void append_field(NSMutableData *buffer, NSData *field) {
+    UInt32 len = (UInt32)field.length;
+    [buffer appendBytes:&len length:sizeof(len)];
+    [buffer appendData:field];
+}
+
+// sha256(kind + algorithm + key1.data + key2.data), length prefixed;
+// nil when no digester (not memoized)
+static NSData *match_key(UInt8 kind, id<MKCryptographyKey> key1, id<MKCryptographyKey> key2) {
+    if (![MKSHA256 getDigester]) {
+        return nil;
+    }
+    NSData *data1 = [key1 data];
+    NSData *data2 = [key2 data];
+    if (!data1 || !data2) {
+        return nil;
+    }
+    NSMutableData *buffer = [[NSMutableData alloc] initWithCapacity:(data1.length + data2.length + 32)];
+    [buffer appendBytes:&kind length:1];
+    append_field(buffer, MKUTF8Encode([key1 algorithm] ?: @""));
+    append_field(buffer, data1);
+    append_field(buffer, data2);
+    NSData *digest = MKSHA256Digest(buffer);
+    // do not keep secret key bytes around
+    [buffer resetBytesInRange:NSMakeRange(0, buffer.length)];
+    return digest;
+}
+
 BOOL MKMatchAsymmetricKeys(id<MKSignKey> sKey, id<MKVerifyKey> pKey) {
+    NSData *key = match_key('A', sKey, pKey);
+    NSNumber *res = key ? [match_cache() objectForKey:key] : nil;
+    if (res) {
+        return [res boolValue];
+    }
     NSData *data = MKMakePromise();
     NSData *signature = [sKey sign:data];
-    return [pKey verify:data withSignature:signature];
+    BOOL ok = [pKey verify:data withSignature:signature];
+    if (key) {
+        [match_cache() setObject:@(ok) forKey:key];
+    }
+    return ok;
+}
+
+void MKMatchKeysClearCache(void) {
+    [match_cache() removeAllObjects];
+}
+
+// compare without early exit
+static BOOL constant_time_equal(NSData *a, NSData *b) {
+    NSUInteger len = a.length;
+    if (len != b.length) {
+        return NO;
+    }
+    const volatile UInt8 *p = a.bytes;
+    const volatile UInt8 *q = b.bytes;
+    UInt8 diff = 0;
+    for (NSUInteger i = 0; i < len; ++i) {
+        diff |= p[i] ^ q[i];
+    }
+    return diff == 0;
+}
+
+// extra params, reused by current thread
+static NSMutableDictionary<NSString *, id> *thread_params(void) {
+    NSMutableDictionary *dict = [[NSThread currentThread] threadDictionary];
+    NSMutableDictionary *params = [dict objectForKey:@"MKMatchSymmetricKeys.params"];
+    if (!params) {
+        params = [[NSMutableDictionary alloc] initWithCapacity:4];
+        [dict setObject:params forKey:@"MKMatchSymmetricKeys.params"];
+    } else {
+        [params removeAllObjects];
+    }
+    return params;
 }
 
 BOOL MKMatchSymmetricKeys(id<MKEncryptKey> encKey, id<MKDecryptKey> decKey) {
-    NSMutableDictionary<NSString *, id> *extra = [[NSMutableDictionary alloc] init];
+    NSString *algorithm = [encKey algorithm];
+    if (algorithm && [algorithm isEqualToString:[decKey algorithm]]) {
+        // same algorithm, compare key material directly
+        NSData *data1 = [encKey data];
+        NSData *data2 = [decKey data];
+        if (data1 && data2) {
+            return constant_time_equal(data1, data2);
+        }
+    }
+    NSData *key = match_key('S', encKey, decKey);
+    NSNumber *res = key ? [match_cache() objectForKey:key] : nil;
+    if (res) {
+        return [res boolValue];
+    }
+    NSMutableDictionary<NSString *, id> *extra = thread_params();
     NSData *data = MKMakePromise();
     NSData *ciphertext = [encKey encrypt:data extra:extra];
     NSData *plaintext = [decKey decrypt:ciphertext params:extra];
-    return [data isEqualToData:plaintext];
+    [extra removeAllObjects];
+    BOOL ok = [data isEqualToData:plaintext];
+    if (key) {
+        [match_cache() setObject:@(ok) forKey:key];
+    }
+    return ok;
 }
 
 @implementation MKSharedCryptoExtensions
@@ -187,6 +187,16 @@ _Nullable __kindof id<MKMDocument> MKMDocumentParse(_Nullable id doc);
 
 NSMutableArray<id<MKMDocument>> *MKMDocumentConvert(NSArray<id> *array);
 
+/**
+ *  Parse documents one by one from elements enumerator
+ *  (e.g. MKJSONArrayReader), without materializing the whole array
+ *
+ * @param elements - document info enumerator
+ * @param block    - handler for each document parsed
+ */
+void MKMDocumentEnumerate(NSEnumerator<id> *elements,
+                          void (NS_NOESCAPE ^block)(id<MKMDocument> doc, BOOL *stop));
+
 NSMutableArray<NSDictionary *> *MKMDocumentRevert(NSArray<id<MKMDocument>> *documents);
 
 #ifdef __cplusplus
@@ -85,6 +85,19 @@ NSMutableArray<id<MKMDocument>> *MKMDocumentConvert(NSArray<id> *array) {
     return documents;
 }
 
+void MKMDocumentEnumerate(NSEnumerator<id> *elements,
+                          void (NS_NOESCAPE ^block)(id<MKMDocument> doc, BOOL *stop)) {
+    BOOL stop = NO;
+    id<MKMDocument> doc;
+    id obj;
+    while (!stop && (obj = [elements nextObject])) {
+        doc = MKMDocumentParse(obj);
+        if (doc) {
+            block(doc, &stop);
+        }
+    }
+}
+
 NSMutableArray<NSDictionary *> *MKMDocumentRevert(NSArray<id<MKMDocument>> *documents) {
     NSMutableArray<NSDictionary *> *array;
     array = [[NSMutableArray alloc] initWithCapacity:documents.count];
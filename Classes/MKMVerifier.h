@@ -0,0 +1,86 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKMVerifier.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol MKVerifyKey;
+@protocol MKMMeta;
+@protocol MKMDocument;
+
+/*
+ *  Verification Engine
+ *  ~~~~~~~~~~~~~~~~~~~
+ *  Verify metas and documents on a concurrent queue (GCD thread pool
+ *  sized to the cores), instead of the calling thread.
+ *
+ *  Identical jobs in flight are merged: all callers get the result of the
+ *  one verification, together with the object that was actually verified
+ *  (a document refreshes its properties only when verified, so use the
+ *  returned one). Jobs are identified by SHA-256 digest, so nothing is
+ *  merged before a digester is set.
+ *
+ *  Completion blocks are called on a private queue.
+ */
+@interface MKMVerificationEngine : NSObject
+
++ (instancetype)sharedInstance;
+
+/**
+ *  Verify meta fingerprint
+ *
+ * @param meta  - meta info
+ * @param block - callback with the verified meta and result
+ */
+- (void)verifyMeta:(id<MKMMeta>)meta
+        completion:(void (^)(id<MKMMeta> meta, BOOL valid))block;
+
+/**
+ *  Verify document signature
+ *
+ * @param doc   - document info
+ * @param PK    - public key in meta.key (or visa.key)
+ * @param block - callback with the verified document and result
+ */
+- (void)verifyDocument:(id<MKMDocument>)doc
+               withKey:(id<MKVerifyKey>)PK
+            completion:(void (^)(id<MKMDocument> doc, BOOL valid))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
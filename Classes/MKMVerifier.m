@@ -0,0 +1,164 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKMVerifier.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <os/lock.h>
+
+#import "MKAsymmetricKey.h"
+#import "MKCanonicalJSON.h"
+#import "MKDigester.h"
+#import "MKMMeta.h"
+#import "MKMTai.h"
+
+#import "MKMVerifier.h"
+
+typedef void (^MKMVerifyCallback)(id object, BOOL valid);
+
+@interface MKMVerificationEngine () {
+    
+    dispatch_queue_t _queue;
+    
+    os_unfair_lock _lock;
+    // job digest => callbacks waiting
+    NSMutableDictionary<NSData *, NSMutableArray<MKMVerifyCallback> *> *_pending;
+}
+
+@end
+
+@implementation MKMVerificationEngine
+
+static MKMVerificationEngine *s_engine = nil;
+
++ (instancetype)sharedInstance {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        s_engine = [[self alloc] init];
+    });
+    return s_engine;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        dispatch_queue_attr_t attr;
+        attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_CONCURRENT, QOS_CLASS_UTILITY, 0);
+        _queue = dispatch_queue_create("chat.dim.mkm.verify", attr);
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _pending = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+// sha256(kind + canonical_json(info) + key.data)
+- (nullable NSData *)_digest:(UInt8)kind info:(NSDictionary *)info key:(nullable id<MKVerifyKey>)PK {
+    if (![MKSHA256 getDigester]) {
+        // cannot be deduplicated
+        return nil;
+    }
+    NSMutableData *buffer = [[NSMutableData alloc] initWithCapacity:1024];
+    [buffer appendBytes:&kind length:1];
+    if (!MKCanonicalJSONAppend(info, buffer)) {
+        // cannot be deduplicated
+        return nil;
+    }
+    NSData *data = [PK data];
+    if (data) {
+        [buffer appendData:data];
+    }
+    return MKSHA256Digest(buffer);
+}
+
+- (void)_submit:(nullable NSData *)job
+         object:(id)object
+       callback:(MKMVerifyCallback)block
+         verify:(BOOL (^)(void))task {
+    if (!job) {
+        // not deduplicated
+        dispatch_async(_queue, ^{
+            BOOL valid;
+            @autoreleasepool {
+                valid = task();
+            }
+            block(object, valid);
+        });
+        return;
+    }
+    os_unfair_lock_lock(&_lock);
+    NSMutableArray<MKMVerifyCallback> *waiting = [_pending objectForKey:job];
+    BOOL running = waiting != nil;
+    if (!running) {
+        waiting = [[NSMutableArray alloc] initWithCapacity:1];
+        [_pending setObject:waiting forKey:job];
+    }
+    [waiting addObject:block];
+    os_unfair_lock_unlock(&_lock);
+    if (running) {
+        // same job in flight, wait for its result
+        return;
+    }
+    dispatch_async(_queue, ^{
+        BOOL valid;
+        @autoreleasepool {
+            valid = task();
+        }
+        NSArray<MKMVerifyCallback> *callbacks;
+        os_unfair_lock_lock(&self->_lock);
+        callbacks = [self->_pending objectForKey:job];
+        [self->_pending removeObjectForKey:job];
+        os_unfair_lock_unlock(&self->_lock);
+        for (MKMVerifyCallback callback in callbacks) {
+            callback(object, valid);
+        }
+    });
+}
+
+- (void)verifyMeta:(id<MKMMeta>)meta
+        completion:(void (^)(id<MKMMeta>, BOOL))block {
+    NSData *job = [self _digest:'M' info:[meta dictionary] key:nil];
+    [self _submit:job object:meta callback:block verify:^BOOL{
+        return [meta isValid];
+    }];
+}
+
+- (void)verifyDocument:(id<MKMDocument>)doc
+               withKey:(id<MKVerifyKey>)PK
+            completion:(void (^)(id<MKMDocument>, BOOL))block {
+    NSData *job = [self _digest:'D' info:[doc dictionary] key:PK];
+    [self _submit:job object:doc callback:block verify:^BOOL{
+        return [doc verify:PK];
+    }];
+}
+
+@end
@@ -0,0 +1,153 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKAESStream.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <MingKeMing/MKSymmetricKey.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ *  AES Stream (reference)
+ *  ~~~~~~~~~~~~~~~~~~~~~~
+ *  AES-CTR with HMAC-SHA256 over (IV + ciphertext), encrypt-then-MAC:
+ *
+ *      params: {
+ *          IV  : "{BASE64_ENCODE}",  // 16 bytes, random when encrypting
+ *          tag : "{BASE64_ENCODE}",  // 32 bytes, given when decrypting
+ *      }
+ *
+ *  Memory stays constant whatever the data size is.
+ *  When decrypting, plaintext chunks come out before the tag is checked,
+ *  so discard them if 'finish' returns nil.
+ *
+ *  A symmetric key can implement 'encryptStream:'/'decryptStream:' with it:
+ *
+ *      - (id<MKCipherStream>)encryptStream:(NSMutableDictionary *)params {
+ *          return [MKAESStream encryptStreamWithKey:self.data params:params];
+ *      }
+ */
+@interface MKAESStream : NSObject <MKCipherStream>
+
+@property (readonly, strong, nonatomic, nullable) NSData *tag;
+
+/**
+ *  Create encrypting stream
+ *
+ * @param key    - AES key (16/24/32 bytes)
+ * @param params - to store 'IV'; the 'tag' will be set on finish
+ * @return nil on error
+ */
++ (nullable instancetype)encryptStreamWithKey:(NSData *)key
+                                       params:(nullable NSMutableDictionary<NSString *, id> *)params;
+
+/**
+ *  Create decrypting stream
+ *
+ * @param key    - AES key (16/24/32 bytes)
+ * @param params - with 'IV' and 'tag'
+ * @return nil on error
+ */
++ (nullable instancetype)decryptStreamWithKey:(NSData *)key
+                                       params:(NSDictionary<NSString *, id> *)params;
+
+@end
+
+/*
+ *  Prepared AES Context
+ *  ~~~~~~~~~~~~~~~~~~~~
+ *  Keeps the expanded key schedule and MAC key, so a session key used for
+ *  many messages expands only once. Thread safe: each call checks out an
+ *  expanded cryptor from a small pool (creating one when all are busy).
+ *
+ *  A symmetric key can create it in 'prepare' and use it in the buffer
+ *  methods; output is the same as 'MKAESEncryptInto()'.
+ */
+@interface MKAESContext : NSObject
+
+- (nullable instancetype)initWithKey:(NSData *)key;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (NSInteger)encrypt:(const void *)plaintext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(MKCipherParams *)params;
+
+- (NSInteger)decrypt:(const void *)ciphertext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(const MKCipherParams *)params;
+
+@end
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  One-shot AES-CTR + HMAC-SHA256 into caller's buffer, same format as
+ *  MKAESStream; no buffer allocation, works in place (output == input).
+ *
+ *  NOTICE: the key is expanded into a new CCCryptor on every call, which
+ *          CommonCrypto allocates; for many messages with the same key,
+ *          use MKAESContext, which reuses its cryptors.
+ *
+ *  Symmetric keys can implement the buffer methods with them:
+ *
+ *      - (NSInteger)encrypt:(const void *)plaintext length:(NSUInteger)length
+ *                    output:(void *)output capacity:(NSUInteger)capacity
+ *                    params:(MKCipherParams *)params {
+ *          NSData *pwd = self.data;
+ *          return MKAESEncryptInto(pwd.bytes, pwd.length, plaintext, length,
+ *                                  output, capacity, params);
+ *      }
+ *
+ * @return output length (same as input); -1 on error
+ */
+NSInteger MKAESEncryptInto(const void *key, NSUInteger keyLength,
+                           const void *plaintext, NSUInteger length,
+                           void *output, NSUInteger capacity,
+                           MKCipherParams *params);
+
+// -1 on error, or tag not matched
+NSInteger MKAESDecryptInto(const void *key, NSUInteger keyLength,
+                           const void *ciphertext, NSUInteger length,
+                           void *output, NSUInteger capacity,
+                           const MKCipherParams *params);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,437 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKAESStream.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <os/lock.h>
+
+#import <CommonCrypto/CommonCryptor.h>
+#import <CommonCrypto/CommonHMAC.h>
+#import <CommonCrypto/CommonRandom.h>
+
+#import "MKDataCoder.h"
+
+#import "MKAESStream.h"
+
+#define MKAESStreamIVSize   kCCBlockSizeAES128
+#define MKAESStreamTagSize  CC_SHA256_DIGEST_LENGTH
+
+static inline BOOL is_aes_key_size(NSUInteger len) {
+    return len == kCCKeySizeAES128 || len == kCCKeySizeAES192 || len == kCCKeySizeAES256;
+}
+
+// mac_key = HMAC-SHA256(key, "MKAESStream.mac")
+static void derive_mac_key(const void *key, size_t keyLength, UInt8 out[CC_SHA256_DIGEST_LENGTH]) {
+    static const char label[] = "MKAESStream.mac";
+    CCHmac(kCCHmacAlgSHA256, key, keyLength, label, sizeof(label) - 1, out);
+}
+
+// compare without early exit
+static BOOL constant_time_equal(const UInt8 *a, const UInt8 *b, size_t len) {
+    UInt8 diff = 0;
+    for (size_t i = 0; i < len; ++i) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+@interface MKAESStream () {
+    
+    CCCryptorRef _cryptor;
+    CCHmacContext _hmac;
+    
+    BOOL _encrypting;
+    BOOL _finished;
+    
+    NSData *_expectedTag;  // decrypting
+    NSMutableDictionary<NSString *, id> *_params;  // encrypting
+}
+
+@property (strong, nonatomic, nullable) NSData *tag;
+
+@end
+
+@implementation MKAESStream
+
+- (nullable instancetype)initWithKey:(NSData *)key
+                                  iv:(NSData *)iv
+                          encrypting:(BOOL)encrypting {
+    if (!is_aes_key_size(key.length) || iv.length != MKAESStreamIVSize) {
+        return nil;
+    }
+    if (self = [super init]) {
+        // CTR runs the same in both directions
+        CCCryptorStatus status;
+        status = CCCryptorCreateWithMode(kCCEncrypt, kCCModeCTR, kCCAlgorithmAES,
+                                         ccNoPadding, iv.bytes, key.bytes, key.length,
+                                         NULL, 0, 0, kCCModeOptionCTR_BE, &_cryptor);
+        if (status != kCCSuccess) {
+            return nil;
+        }
+        UInt8 macKey[CC_SHA256_DIGEST_LENGTH];
+        derive_mac_key(key.bytes, key.length, macKey);
+        CCHmacInit(&_hmac, kCCHmacAlgSHA256, macKey, sizeof(macKey));
+        memset_s(macKey, sizeof(macKey), 0, sizeof(macKey));
+        CCHmacUpdate(&_hmac, iv.bytes, iv.length);
+        _encrypting = encrypting;
+        _finished = NO;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_cryptor) {
+        CCCryptorRelease(_cryptor);
+    }
+    memset_s(&_hmac, sizeof(_hmac), 0, sizeof(_hmac));
+}
+
++ (nullable instancetype)encryptStreamWithKey:(NSData *)key
+                                       params:(nullable NSMutableDictionary<NSString *, id> *)params {
+    UInt8 iv[MKAESStreamIVSize];
+    if (CCRandomGenerateBytes(iv, sizeof(iv)) != kCCSuccess) {
+        return nil;
+    }
+    NSData *ivData = [[NSData alloc] initWithBytes:iv length:sizeof(iv)];
+    MKAESStream *stream = [[self alloc] initWithKey:key iv:ivData encrypting:YES];
+    if (stream) {
+        [params setObject:MKBase64Encode(ivData) forKey:@"IV"];
+        stream->_params = params;
+    }
+    return stream;
+}
+
++ (nullable instancetype)decryptStreamWithKey:(NSData *)key
+                                       params:(NSDictionary<NSString *, id> *)params {
+    id iv = [params objectForKey:@"IV"];
+    id tag = [params objectForKey:@"tag"];
+    NSData *ivData = [iv isKindOfClass:[NSString class]] ? MKBase64Decode(iv) : nil;
+    NSData *tagData = [tag isKindOfClass:[NSString class]] ? MKBase64Decode(tag) : nil;
+    if (tagData.length != MKAESStreamTagSize) {
+        // unauthenticated data not accepted
+        return nil;
+    }
+    MKAESStream *stream = [[self alloc] initWithKey:key iv:ivData encrypting:NO];
+    if (stream) {
+        stream->_expectedTag = tagData;
+    }
+    return stream;
+}
+
+- (NSInteger)update:(const void *)input length:(NSUInteger)length
+             output:(void *)output capacity:(NSUInteger)capacity {
+    if (_finished || capacity < length) {
+        return -1;
+    }
+    if (!_encrypting) {
+        CCHmacUpdate(&_hmac, input, length);
+    }
+    size_t moved = 0;
+    CCCryptorStatus status = CCCryptorUpdate(_cryptor, input, length, output, capacity, &moved);
+    if (status != kCCSuccess) {
+        return -1;
+    }
+    if (_encrypting) {
+        CCHmacUpdate(&_hmac, output, moved);
+    }
+    return moved;
+}
+
+- (nullable NSData *)update:(NSData *)chunk {
+    NSUInteger length = chunk.length;
+    NSMutableData *output = [[NSMutableData alloc] initWithLength:length];
+    NSInteger moved = [self update:chunk.bytes length:length
+                            output:output.mutableBytes capacity:length];
+    if (moved < 0) {
+        return nil;
+    }
+    [output setLength:moved];
+    return output;
+}
+
+- (nullable NSData *)finish {
+    if (_finished) {
+        return nil;
+    }
+    _finished = YES;
+    UInt8 mac[MKAESStreamTagSize];
+    CCHmacFinal(&_hmac, mac);
+    if (_encrypting) {
+        NSData *tag = [[NSData alloc] initWithBytes:mac length:sizeof(mac)];
+        self.tag = tag;
+        [_params setObject:MKBase64Encode(tag) forKey:@"tag"];
+    } else if (!constant_time_equal(mac, _expectedTag.bytes, sizeof(mac))) {
+        return nil;
+    } else {
+        self.tag = _expectedTag;
+    }
+    // CTR has no padding, nothing left
+    return [NSData data];
+}
+
+@end
+
+#pragma mark - One-shot
+
+// blocks of key stream per 'CCCryptorUpdate'
+#define MKAESBatchBlocks  32
+
+// big-endian 128-bit increment
+static inline void increment_counter(UInt8 counter[kCCBlockSizeAES128]) {
+    for (int i = kCCBlockSizeAES128 - 1; i >= 0; --i) {
+        if (++counter[i] != 0) {
+            break;
+        }
+    }
+}
+
+// output = input ^ AES-ECB(counter++)
+static BOOL ctr_xor_with(CCCryptorRef cryptor, const UInt8 iv[kCCBlockSizeAES128],
+                         const UInt8 *input, size_t length, UInt8 *output) {
+    UInt8 counter[kCCBlockSizeAES128];
+    memcpy(counter, iv, sizeof(counter));
+    UInt8 blocks[MKAESBatchBlocks * kCCBlockSizeAES128];
+    UInt8 stream[sizeof(blocks)];
+    CCCryptorStatus status = kCCSuccess;
+    size_t offset = 0, size, moved, n, i;
+    while (offset < length && status == kCCSuccess) {
+        size = MIN(sizeof(blocks), length - offset);
+        n = (size + kCCBlockSizeAES128 - 1) / kCCBlockSizeAES128;
+        for (i = 0; i < n; ++i) {
+            memcpy(blocks + i * kCCBlockSizeAES128, counter, kCCBlockSizeAES128);
+            increment_counter(counter);
+        }
+        status = CCCryptorUpdate(cryptor, blocks, n * kCCBlockSizeAES128,
+                                 stream, sizeof(stream), &moved);
+        for (i = 0; i < size; ++i) {
+            output[offset + i] = input[offset + i] ^ stream[i];
+        }
+        offset += size;
+    }
+    memset_s(stream, sizeof(stream), 0, sizeof(stream));
+    return status == kCCSuccess;
+}
+
+// one cryptor per call, released (and cleared) before return
+static BOOL ctr_xor(const void *key, size_t keyLength, const UInt8 iv[kCCBlockSizeAES128],
+                    const UInt8 *input, size_t length, UInt8 *output) {
+    CCCryptorRef cryptor = NULL;
+    CCCryptorStatus status;
+    status = CCCryptorCreateWithMode(kCCEncrypt, kCCModeECB, kCCAlgorithmAES,
+                                     ccNoPadding, NULL, key, keyLength,
+                                     NULL, 0, 0, 0, &cryptor);
+    if (status != kCCSuccess) {
+        return NO;
+    }
+    BOOL ok = ctr_xor_with(cryptor, iv, input, length, output);
+    CCCryptorRelease(cryptor);
+    return ok;
+}
+
+// tag = HMAC-SHA256(mac_key, iv + ciphertext)
+static void compute_tag_with(const UInt8 macKey[CC_SHA256_DIGEST_LENGTH], const UInt8 *iv,
+                             const void *ciphertext, size_t length, UInt8 tag[MKAESStreamTagSize]) {
+    CCHmacContext ctx;
+    CCHmacInit(&ctx, kCCHmacAlgSHA256, macKey, CC_SHA256_DIGEST_LENGTH);
+    CCHmacUpdate(&ctx, iv, MKAESStreamIVSize);
+    CCHmacUpdate(&ctx, ciphertext, length);
+    CCHmacFinal(&ctx, tag);
+    memset_s(&ctx, sizeof(ctx), 0, sizeof(ctx));
+}
+
+static void compute_tag(const void *key, size_t keyLength, const UInt8 *iv,
+                        const void *ciphertext, size_t length, UInt8 tag[MKAESStreamTagSize]) {
+    UInt8 macKey[CC_SHA256_DIGEST_LENGTH];
+    derive_mac_key(key, keyLength, macKey);
+    compute_tag_with(macKey, iv, ciphertext, length, tag);
+    memset_s(macKey, sizeof(macKey), 0, sizeof(macKey));
+}
+
+NSInteger MKAESEncryptInto(const void *key, NSUInteger keyLength,
+                           const void *plaintext, NSUInteger length,
+                           void *output, NSUInteger capacity,
+                           MKCipherParams *params) {
+    if (!is_aes_key_size(keyLength) || capacity < length) {
+        return -1;
+    }
+    if (CCRandomGenerateBytes(params->iv, MKAESStreamIVSize) != kCCSuccess) {
+        return -1;
+    }
+    params->ivLength = MKAESStreamIVSize;
+    if (!ctr_xor(key, keyLength, params->iv, plaintext, length, output)) {
+        return -1;
+    }
+    compute_tag(key, keyLength, params->iv, output, length, params->tag);
+    params->tagLength = MKAESStreamTagSize;
+    return length;
+}
+
+NSInteger MKAESDecryptInto(const void *key, NSUInteger keyLength,
+                           const void *ciphertext, NSUInteger length,
+                           void *output, NSUInteger capacity,
+                           const MKCipherParams *params) {
+    if (!is_aes_key_size(keyLength) || capacity < length ||
+        params->ivLength != MKAESStreamIVSize || params->tagLength != MKAESStreamTagSize) {
+        return -1;
+    }
+    // check before decrypting, ciphertext may be overwritten in place
+    UInt8 tag[MKAESStreamTagSize];
+    compute_tag(key, keyLength, params->iv, ciphertext, length, tag);
+    if (!constant_time_equal(tag, params->tag, sizeof(tag))) {
+        return -1;
+    }
+    if (!ctr_xor(key, keyLength, params->iv, ciphertext, length, output)) {
+        return -1;
+    }
+    return length;
+}
+
+#pragma mark - Prepared context
+
+// idle cryptors kept for reuse
+#define MKAESContextPoolSize  8
+
+@interface MKAESContext () {
+    
+    NSData *_key;
+    UInt8 _macKey[CC_SHA256_DIGEST_LENGTH];
+    
+    os_unfair_lock _lock;
+    CCCryptorRef _pool[MKAESContextPoolSize];  // expanded ECB cryptors
+    NSUInteger _idle;
+}
+
+@end
+
+@implementation MKAESContext
+
+- (nullable instancetype)initWithKey:(NSData *)key {
+    if (!is_aes_key_size(key.length)) {
+        return nil;
+    }
+    if (self = [super init]) {
+        _key = [key copy];
+        derive_mac_key(_key.bytes, _key.length, _macKey);
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _idle = 0;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (NSUInteger i = 0; i < _idle; ++i) {
+        CCCryptorRelease(_pool[i]);
+    }
+    memset_s(_macKey, sizeof(_macKey), 0, sizeof(_macKey));
+}
+
+// take an idle cryptor, or expand the key for a new one
+- (CCCryptorRef)_checkout {
+    CCCryptorRef cryptor = NULL;
+    os_unfair_lock_lock(&_lock);
+    if (_idle > 0) {
+        cryptor = _pool[--_idle];
+    }
+    os_unfair_lock_unlock(&_lock);
+    if (!cryptor) {
+        CCCryptorStatus status;
+        status = CCCryptorCreate(kCCEncrypt, kCCAlgorithmAES, kCCOptionECBMode,
+                                 _key.bytes, _key.length, NULL, &cryptor);
+        if (status != kCCSuccess) {
+            return NULL;
+        }
+    }
+    return cryptor;
+}
+
+// ECB keeps no state between blocks, so it can be reused as is
+- (void)_checkin:(CCCryptorRef)cryptor {
+    os_unfair_lock_lock(&_lock);
+    if (_idle < MKAESContextPoolSize) {
+        _pool[_idle++] = cryptor;
+        cryptor = NULL;
+    }
+    os_unfair_lock_unlock(&_lock);
+    if (cryptor) {
+        CCCryptorRelease(cryptor);
+    }
+}
+
+- (NSInteger)encrypt:(const void *)plaintext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(MKCipherParams *)params {
+    if (capacity < length) {
+        return -1;
+    }
+    if (CCRandomGenerateBytes(params->iv, MKAESStreamIVSize) != kCCSuccess) {
+        return -1;
+    }
+    params->ivLength = MKAESStreamIVSize;
+    CCCryptorRef cryptor = [self _checkout];
+    if (!cryptor) {
+        return -1;
+    }
+    BOOL ok = ctr_xor_with(cryptor, params->iv, plaintext, length, output);
+    [self _checkin:cryptor];
+    if (!ok) {
+        return -1;
+    }
+    compute_tag_with(_macKey, params->iv, output, length, params->tag);
+    params->tagLength = MKAESStreamTagSize;
+    return length;
+}
+
+- (NSInteger)decrypt:(const void *)ciphertext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(const MKCipherParams *)params {
+    if (capacity < length ||
+        params->ivLength != MKAESStreamIVSize || params->tagLength != MKAESStreamTagSize) {
+        return -1;
+    }
+    UInt8 tag[MKAESStreamTagSize];
+    compute_tag_with(_macKey, params->iv, ciphertext, length, tag);
+    if (!constant_time_equal(tag, params->tag, sizeof(tag))) {
+        return -1;
+    }
+    CCCryptorRef cryptor = [self _checkout];
+    if (!cryptor) {
+        return -1;
+    }
+    BOOL ok = ctr_xor_with(cryptor, params->iv, ciphertext, length, output);
+    [self _checkin:cryptor];
+    return ok ? length : -1;
+}
+
+@end
@@ -74,6 +74,91 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)matchSignKey:(id<MKSignKey>)sKey;
 
+@optional
+
+/**
+ *  Verify many signatures at once
+ *  (for algorithms with batch verification or shared precomputation)
+ *
+ * @param messages   - data array
+ * @param signatures - signature array, same count as messages
+ * @return indexes of the valid items
+ */
+- (NSIndexSet *)verifyBatch:(NSArray<NSData *> *)messages
+             withSignatures:(NSArray<NSData *> *)signatures;
+
+/**
+ *  Precompute per-key state for verifying (e.g. Montgomery context for
+ *  RSA, decompressed point and window tables for EC), keep it with the
+ *  key object until 'unprepare'
+ */
+- (void)prepare;
+
+/**
+ *  Release the precomputed state
+ */
+- (void)unprepare;
+
 @end
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Verify many signatures with the same key
+ *  (use 'verifyBatch:withSignatures:' if supported, else one by one)
+ *
+ * @param PK         - verify key
+ * @param messages   - data array
+ * @param signatures - signature array, same count as messages
+ * @return indexes of the valid items; empty when counts not match
+ */
+NSIndexSet *MKVerifyBatch(id<MKVerifyKey> PK,
+                          NSArray<NSData *> *messages,
+                          NSArray<NSData *> *signatures);
+
+/**
+ *  Verify many signatures with the same key, across all cores
+ *  (use 'verifyBatch:withSignatures:' if supported)
+ *
+ * @param PK         - verify key (must be thread safe)
+ * @param messages   - data array
+ * @param signatures - signature array, same count as messages
+ * @return indexes of the valid items; empty when counts not match
+ */
+NSIndexSet *MKVerifyBatchConcurrently(id<MKVerifyKey> PK,
+                                      NSArray<NSData *> *messages,
+                                      NSArray<NSData *> *signatures);
+
+/**
+ *  Prepare verify key for repeated use
+ *  (prepared keys are kept in a bounded registry, the least recently
+ *   used one is dropped when over limit; a key is unprepared only after
+ *   it is dropped and all leases are released)
+ *
+ *  Usage:
+ *      NS_VALID_UNTIL_END_OF_SCOPE id lease = MKVerifyKeyPrepare(PK);
+ *      // verify with PK ...
+ *
+ *  Keys are prepared outside the registry lock, so preparing one key
+ *  does not block others; callers asking for a key being prepared wait
+ *  for it.
+ *
+ * @param PK - verify key
+ * @return lease keeping the key prepared, hold it while verifying;
+ *         nil when the key cannot be prepared
+ */
+_Nullable id MKVerifyKeyPrepare(id<MKVerifyKey> PK);
+
+/**
+ *  Drop all keys from registry
+ *  (keys still leased are unprepared when their leases are released)
+ */
+void MKVerifyKeyUnprepareAll(void);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
 NS_ASSUME_NONNULL_END
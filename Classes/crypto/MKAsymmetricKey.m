@@ -0,0 +1,245 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKAsymmetricKey.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import "MKLRUCache.h"
+
+#import "MKAsymmetricKey.h"
+
+// fewer items are not worth dispatching
+#define MKVerifyBatchConcurrentMinCount  8
+
+// more items are worth preparing the key
+#define MKVerifyBatchPrepareMinCount     4
+
+// max prepared keys
+#define MKVerifyKeyPreparedLimit         64
+
+/*
+ *  Keeps a key prepared while referenced: once by the registry (until
+ *  evicted), and once by each lease in use; the key is unprepared when
+ *  the last reference is released.
+ */
+@interface MKPreparedKeyHolder : NSObject {
+    
+@public
+    id<MKVerifyKey> _key;
+    NSValue *_identity;
+    NSUInteger _refs;     // guarded by 'active_holders()'
+    BOOL _registered;     // in registry
+    dispatch_group_t _ready;  // left when the key is prepared
+}
+
+@end
+
+@implementation MKPreparedKeyHolder
+
+@end
+
+/*
+ *  Returned to callers, releases its holder reference on dealloc
+ */
+@interface MKPreparedKeyLease : NSObject {
+    
+    MKPreparedKeyHolder *_holder;
+}
+
+- (instancetype)initWithHolder:(MKPreparedKeyHolder *)holder;
+
+@end
+
+// key identity => holder, for all keys prepared now
+static NSMutableDictionary<NSValue *, MKPreparedKeyHolder *> *active_holders(void) {
+    static NSMutableDictionary *s_holders = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        s_holders = [[NSMutableDictionary alloc] init];
+    });
+    return s_holders;
+}
+
+static void holder_release(MKPreparedKeyHolder *holder) {
+    NSMutableDictionary *holders = active_holders();
+    @synchronized (holders) {
+        NSCAssert(holder->_refs > 0, @"prepared key refs error: %@", holder->_key);
+        if (--holder->_refs == 0) {
+            [holders removeObjectForKey:holder->_identity];
+            [holder->_key unprepare];
+        }
+    }
+}
+
+@implementation MKPreparedKeyLease
+
+- (instancetype)initWithHolder:(MKPreparedKeyHolder *)holder {
+    if (self = [super init]) {
+        _holder = holder;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    holder_release(_holder);
+}
+
+@end
+
+// bounded, holding one reference of each recently prepared key
+static MKLRUCache<NSValue *, MKPreparedKeyHolder *> *prepared_keys(void) {
+    static MKLRUCache *s_keys = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        s_keys = [[MKLRUCache alloc] initWithCountLimit:MKVerifyKeyPreparedLimit];
+        s_keys.evictionHandler = ^(NSValue *identity, MKPreparedKeyHolder *holder) {
+            @synchronized (active_holders()) {
+                holder->_registered = NO;
+            }
+            holder_release(holder);
+        };
+    });
+    return s_keys;
+}
+
+id MKVerifyKeyPrepare(id<MKVerifyKey> PK) {
+    if (![PK respondsToSelector:@selector(prepare)]) {
+        return nil;
+    }
+    // holder retains the key, so the address will not be reused meanwhile
+    NSValue *identity = [NSValue valueWithNonretainedObject:PK];
+    NSMutableDictionary *holders = active_holders();
+    MKPreparedKeyHolder *holder;
+    BOOL needsPrepare = NO;
+    BOOL needsRegister = NO;
+    @synchronized (holders) {
+        holder = [holders objectForKey:identity];
+        if (!holder) {
+            holder = [[MKPreparedKeyHolder alloc] init];
+            holder->_key = PK;
+            holder->_identity = identity;
+            holder->_refs = 0;
+            holder->_registered = NO;
+            holder->_ready = dispatch_group_create();
+            dispatch_group_enter(holder->_ready);
+            [holders setObject:holder forKey:identity];
+            needsPrepare = YES;
+        }
+        // one for the lease
+        holder->_refs += 1;
+        if (!holder->_registered) {
+            // one for the registry
+            holder->_refs += 1;
+            holder->_registered = YES;
+            needsRegister = YES;
+        }
+    }
+    if (needsPrepare) {
+        // slow (e.g. RSA, EC tables), so other keys are not blocked;
+        // the previous holder of this key (if any) was unprepared before
+        // it left 'active_holders()'
+        [PK prepare];
+        dispatch_group_leave(holder->_ready);
+    } else {
+        // prepared (or being prepared) by another caller
+        dispatch_group_wait(holder->_ready, DISPATCH_TIME_FOREVER);
+    }
+    MKLRUCache *registry = prepared_keys();
+    if (needsRegister) {
+        // may evict another one, outside the lock
+        [registry setObject:holder forKey:identity];
+    } else {
+        // touch
+        [registry objectForKey:identity];
+    }
+    return [[MKPreparedKeyLease alloc] initWithHolder:holder];
+}
+
+void MKVerifyKeyUnprepareAll(void) {
+    [prepared_keys() removeAllObjects];
+}
+
+NSIndexSet *MKVerifyBatch(id<MKVerifyKey> PK,
+                          NSArray<NSData *> *messages,
+                          NSArray<NSData *> *signatures) {
+    NSUInteger count = messages.count;
+    if (count != signatures.count) {
+        // count not match
+        return [NSIndexSet indexSet];
+    }
+    if ([PK respondsToSelector:@selector(verifyBatch:withSignatures:)]) {
+        return [PK verifyBatch:messages withSignatures:signatures];
+    }
+    // keep the key prepared until done
+    NS_VALID_UNTIL_END_OF_SCOPE id lease;
+    lease = count >= MKVerifyBatchPrepareMinCount ? MKVerifyKeyPrepare(PK) : nil;
+    NSMutableIndexSet *valid = [[NSMutableIndexSet alloc] init];
+    for (NSUInteger index = 0; index < count; ++index) {
+        if ([PK verify:messages[index] withSignature:signatures[index]]) {
+            [valid addIndex:index];
+        }
+    }
+    return valid;
+}
+
+NSIndexSet *MKVerifyBatchConcurrently(id<MKVerifyKey> PK,
+                                      NSArray<NSData *> *messages,
+                                      NSArray<NSData *> *signatures) {
+    NSUInteger count = messages.count;
+    if (count != signatures.count ||
+        count < MKVerifyBatchConcurrentMinCount ||
+        [PK respondsToSelector:@selector(verifyBatch:withSignatures:)]) {
+        return MKVerifyBatch(PK, messages, signatures);
+    }
+    // keep the key prepared until done
+    NS_VALID_UNTIL_END_OF_SCOPE id lease = MKVerifyKeyPrepare(PK);
+    // one flag per item, written by different threads without locking
+    BOOL *results = calloc(count, sizeof(BOOL));
+    if (!results) {
+        return MKVerifyBatch(PK, messages, signatures);
+    }
+    dispatch_apply(count, DISPATCH_APPLY_AUTO, ^(size_t index) {
+        @autoreleasepool {
+            results[index] = [PK verify:messages[index] withSignature:signatures[index]];
+        }
+    });
+    NSMutableIndexSet *valid = [[NSMutableIndexSet alloc] init];
+    for (NSUInteger index = 0; index < count; ++index) {
+        if (results[index]) {
+            [valid addIndex:index];
+        }
+    }
+    free(results);
+    return valid;
+}
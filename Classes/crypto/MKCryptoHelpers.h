@@ -35,7 +35,7 @@
 //  Copyright © 2023 DIM Group. All rights reserved.
 //
 
-#import <Foundation/Foundation.h>
+#import <MingKeMing/MKLRUCache.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -48,6 +48,8 @@ NS_ASSUME_NONNULL_BEGIN
 @protocol MKPrivateKey;
 @protocol MKPrivateKeyFactory;
 
+@class MKPrivateKeyPool;
+
 @protocol MKSymmetricKeyHelper <NSObject>
 
 - (void)setSymmetricKeyFactory:(id<MKSymmetricKeyFactory>)factory
@@ -88,11 +90,54 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (instancetype)sharedInstance;
 
-@property (strong, nonatomic, nullable) id<MKSymmetricKeyHelper> symmetricHelper;
-
-@property (strong, nonatomic, nullable) id<MKPrivateKeyHelper> privateHelper;
-@property (strong, nonatomic, nullable) id<MKPublicKeyHelper> publicHelper;
+// atomic: helpers, caches and pool can be replaced while other
+// threads are parsing or generating keys; a helper that keeps its key
+// factories in an 'MKFactoryRegistry' can also register factories then
+@property (strong, nullable) id<MKSymmetricKeyHelper> symmetricHelper;
+
+@property (strong, nullable) id<MKPrivateKeyHelper> privateHelper;
+@property (strong, nullable) id<MKPublicKeyHelper> publicHelper;
+
+/**
+ *  Optional cache for parsing public keys, keyed by digest of key info;
+ *  cached key objects are shared, do not modify them.
+ *
+ *  NOTICE: private keys are never cached, a shared private key could
+ *          not be wiped while other threads may still sign with it.
+ */
+@property (strong, nullable) MKLRUCache<NSData *, id<MKPublicKey>> *publicKeyCache;
+
+/**
+ *  Optional cache for session keys parsed from messages
+ *  (keyed by digest of key info; use a cache with time to live),
+ *  keys are prepared (e.g. key schedule expanded) before caching;
+ *  the cached key is never returned, each parse gets its own copy.
+ */
+@property (strong, nullable) MKLRUCache<NSData *, id<MKSymmetricKey>> *symmetricKeyCache;
+
+/**
+ *  Optional pool of pre-generated private keys
+ *  (used by 'MKPrivateKeyGenerate()' before generating synchronously)
+ */
+@property (strong, nullable) MKPrivateKeyPool *keyPool;
 
 @end
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Get cache key for key info
+ *
+ * @param info - key info: { algorithm: "RSA", data: "...", ... }
+ * @return sha256(canonical_json(info)); nil when not cacheable,
+ *         or no SHA-256 digester set
+ */
+NSData * _Nullable MKCryptoKeyCacheKey(_Nullable id info);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
 NS_ASSUME_NONNULL_END
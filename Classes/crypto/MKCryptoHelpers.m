@@ -39,8 +39,37 @@
 //#import "MKPrivateKey.h"
 //#import "MKPublicKey.h"
 
+#import "MKCanonicalJSON.h"
+#import "MKCryptographyKey.h"
+#import "MKDigester.h"
+#import "MKDictionary.h"
+
 #import "MKCryptoHelpers.h"
 
+NSData *MKCryptoKeyCacheKey(id info) {
+    if ([info conformsToProtocol:@protocol(MKCryptographyKey)]) {
+        // parsed already
+        return nil;
+    } else if ([info conformsToProtocol:@protocol(MKDictionary)]) {
+        info = [info dictionary];
+    }
+    if (![info isKindOfClass:[NSDictionary class]] || ![info objectForKey:@"algorithm"]) {
+        return nil;
+    } else if (![MKSHA256 getDigester]) {
+        // not cacheable
+        return nil;
+    }
+    NSMutableData *buffer = [[NSMutableData alloc] initWithCapacity:512];
+    if (!MKCanonicalJSONAppend(info, buffer)) {
+        // not cacheable
+        return nil;
+    }
+    NSData *digest = MKSHA256Digest(buffer);
+    // may contain private key
+    [buffer resetBytesInRange:NSMakeRange(0, buffer.length)];
+    return digest;
+}
+
 @implementation MKCryptoExtensions
 
 static MKCryptoExtensions *s_crypto_ext = nil;
@@ -57,6 +57,55 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/*
+ *  Cipher Stream
+ *  ~~~~~~~~~~~~~
+ *  Encrypt/decrypt data chunk by chunk, so large files can be processed
+ *  in constant memory.
+ */
+@protocol MKCipherStream <NSObject>
+
+/**
+ *  Process next chunk
+ *
+ * @param chunk - input bytes
+ * @return output bytes for this chunk (may be empty); nil on error
+ */
+- (nullable NSData *)update:(NSData *)chunk;
+
+/**
+ *  Finish the stream
+ *
+ * @return last output bytes (may be empty); nil on error
+ */
+- (nullable NSData *)finish;
+
+@optional
+
+/**
+ *  Process next chunk into caller's buffer
+ *
+ * @param input    - input bytes
+ * @param length   - input length
+ * @param output   - output buffer
+ * @param capacity - output buffer size (input length is enough for
+ *                   stream modes)
+ * @return output length; -1 on error
+ */
+- (NSInteger)update:(const void *)input length:(NSUInteger)length
+             output:(void *)output capacity:(NSUInteger)capacity;
+
+/**
+ *  Authentication tag
+ *
+ *      encrypting: available after 'finish';
+ *      decrypting: expected tag is given in params ('tag'),
+ *                  and 'finish' returns nil on mismatch.
+ */
+@property (readonly, strong, nonatomic, nullable) NSData *tag;
+
+@end
+
 @protocol MKEncryptKey <MKCryptographyKey>
 
 /**
@@ -71,6 +120,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (NSData *)encrypt:(NSData *)plaintext extra:(nullable NSMutableDictionary<NSString *, id> *)params;
 
+@optional
+
+/**
+ *  Start encrypting chunk by chunk
+ *
+ * @param params - store extra variables ('IV' for 'AES')
+ * @return cipher stream; nil when not supported
+ */
+- (nullable id<MKCipherStream>)encryptStream:(nullable NSMutableDictionary<NSString *, id> *)params;
+
 @end
 
 @protocol MKDecryptKey <MKCryptographyKey>
@@ -92,6 +151,39 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)matchEncryptKey:(id<MKEncryptKey>)pKey;
 
+@optional
+
+/**
+ *  Start decrypting chunk by chunk
+ *
+ * @param extra - extra params ('IV' for 'AES')
+ * @return cipher stream; nil when not supported
+ */
+- (nullable id<MKCipherStream>)decryptStream:(nullable NSDictionary<NSString *, id> *)extra;
+
 @end
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Encrypt the same plaintext for many members (e.g. group session key)
+ *
+ *      1. members with identical keys (algorithm + data) share one
+ *         encryption; keys with other fields are never shared;
+ *      2. distinct keys are encrypted concurrently across cores;
+ *      3. no extra params, for public keys only.
+ *
+ * @param plaintext - data to encrypt
+ * @param keys      - member => encrypt key (must be thread safe)
+ * @return member => ciphertext; members failed to encrypt are absent
+ */
+NSDictionary<id, NSData *> *MKEncryptFanOut(NSData *plaintext,
+                                            NSDictionary<id, id<MKEncryptKey>> *keys);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
 NS_ASSUME_NONNULL_END
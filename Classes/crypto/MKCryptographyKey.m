@@ -0,0 +1,123 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKCryptographyKey.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <os/lock.h>
+
+#import "MKDigester.h"
+
+#import "MKCryptographyKey.h"
+
+// only "algorithm" and "data", nothing else changes the output
+static BOOL has_params(id<MKEncryptKey> key) {
+    for (NSString *name in [key allKeys]) {
+        if (![name isEqualToString:@"algorithm"] && ![name isEqualToString:@"data"]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+// sha256(algorithm + data), length prefixed; the bytes when no digester
+static NSData *key_identity(NSString *algorithm, NSData *data) {
+    NSData *name = [algorithm dataUsingEncoding:NSUTF8StringEncoding];
+    UInt32 len = (UInt32)name.length;
+    NSMutableData *buffer = [[NSMutableData alloc] initWithCapacity:(4 + len + data.length)];
+    [buffer appendBytes:&len length:sizeof(len)];
+    [buffer appendData:name];
+    [buffer appendData:data];
+    NSData *digest = [MKSHA256 getDigester] ? MKSHA256Digest(buffer) : nil;
+    return digest ? digest : buffer;
+}
+
+NSDictionary<id, NSData *> *MKEncryptFanOut(NSData *plaintext,
+                                            NSDictionary<id, id<MKEncryptKey>> *keys) {
+    // 1. deduplicate: identity of (algorithm, data) => index of unique key
+    NSMutableDictionary<NSData *, NSNumber *> *indexes;
+    indexes = [[NSMutableDictionary alloc] initWithCapacity:keys.count];
+    NSMutableArray<id<MKEncryptKey>> *unique = [[NSMutableArray alloc] initWithCapacity:keys.count];
+    NSMutableDictionary<id, NSNumber *> *members;
+    members = [[NSMutableDictionary alloc] initWithCapacity:keys.count];
+    [keys enumerateKeysAndObjectsUsingBlock:^(id member, id<MKEncryptKey> key, BOOL *stop) {
+        NSString *algorithm = [key algorithm];
+        NSData *data = [key data];
+        if (!algorithm || !data) {
+            return;
+        }
+        NSNumber *index;
+        if (has_params(key)) {
+            // may encrypt differently, not shared
+            index = @(unique.count);
+            [unique addObject:key];
+        } else {
+            NSData *identity = key_identity(algorithm, data);
+            index = [indexes objectForKey:identity];
+            if (!index) {
+                index = @(unique.count);
+                [indexes setObject:index forKey:identity];
+                [unique addObject:key];
+            }
+        }
+        [members setObject:index forKey:member];
+    }];
+    // 2. encrypt concurrently
+    NSUInteger count = unique.count;
+    NSMutableArray *results = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        [results addObject:[NSNull null]];
+    }
+    __block os_unfair_lock lock = OS_UNFAIR_LOCK_INIT;
+    dispatch_apply(count, DISPATCH_APPLY_AUTO, ^(size_t index) {
+        @autoreleasepool {
+            NSData *ciphertext = [unique[index] encrypt:plaintext extra:nil];
+            if (ciphertext) {
+                os_unfair_lock_lock(&lock);
+                [results replaceObjectAtIndex:index withObject:ciphertext];
+                os_unfair_lock_unlock(&lock);
+            }
+        }
+    });
+    // 3. map back to members
+    NSMutableDictionary<id, NSData *> *output;
+    output = [[NSMutableDictionary alloc] initWithCapacity:members.count];
+    [members enumerateKeysAndObjectsUsingBlock:^(id member, NSNumber *index, BOOL *stop) {
+        id ciphertext = [results objectAtIndex:[index unsignedIntegerValue]];
+        if (ciphertext != [NSNull null]) {
+            [output setObject:ciphertext forKey:member];
+        }
+    }];
+    return output;
+}
@@ -36,6 +36,7 @@
 //
 
 #import "MKCryptoHelpers.h"
+#import "MKPrivateKeyPool.h"
 
 #import "MKPrivateKey.h"
 
@@ -51,6 +52,10 @@ void MKPrivateKeySetFactory(NSString *algorithm, id<MKPrivateKeyFactory> factory
 
 id<MKPrivateKey> MKPrivateKeyGenerate(NSString *algorithm) {
     MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
+    id<MKPrivateKey> key = [ext.keyPool takeKey:algorithm];
+    if (key) {
+        return key;
+    }
     return [ext.privateHelper generatePrivateKey:algorithm];
 }
 
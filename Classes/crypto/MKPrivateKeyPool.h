@@ -0,0 +1,102 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKPrivateKeyPool.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol MKPrivateKey;
+
+/*
+ *  Private Key Pool
+ *  ~~~~~~~~~~~~~~~~
+ *  Pre-generate private keys on a background queue, so generating
+ *  (e.g. RSA) keys for new accounts does not block the caller.
+ *
+ *  Enable it with:
+ *      [MKCryptoExtensions sharedInstance].keyPool = pool;
+ *  then 'MKPrivateKeyGenerate()' takes keys from the pool first,
+ *  and generates synchronously when the pool is drained.
+ */
+@interface MKPrivateKeyPool : NSObject
+
+/**
+ *  Statistics
+ */
+@property (readonly) NSUInteger hits;       // served from pool
+@property (readonly) NSUInteger misses;     // pool drained
+@property (readonly) NSUInteger generated;  // keys made in background
+@property (readonly) NSUInteger failures;   // refills stopped by helper
+@property (readonly) double generationRate; // keys per second of generating
+                                            // (speed, idle time excluded)
+
+/**
+ *  Set max pooled keys for algorithm, and start filling
+ *  (filling stops if the helper cannot generate keys for the algorithm,
+ *   counted by 'failures', and restarts on next 'takeKey:')
+ *
+ * @param count     - watermark, 0 to disable
+ * @param algorithm - key algorithm
+ */
+- (void)setWatermark:(NSUInteger)count forAlgorithm:(NSString *)algorithm;
+
+- (NSUInteger)watermarkForAlgorithm:(NSString *)algorithm;
+
+/**
+ *  Current pool depth
+ *
+ * @param algorithm - key algorithm
+ * @return count of keys ready
+ */
+- (NSUInteger)depthForAlgorithm:(NSString *)algorithm;
+
+/**
+ *  Take a pre-generated key, and refill in background
+ *
+ * @param algorithm - key algorithm
+ * @return nil when pool is empty
+ */
+- (nullable id<MKPrivateKey>)takeKey:(NSString *)algorithm;
+
+/**
+ *  Drop all pooled keys
+ */
+- (void)drain;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,216 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKPrivateKeyPool.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <os/lock.h>
+
+#import "MKCryptoHelpers.h"
+#import "MKPrivateKey.h"
+
+#import "MKPrivateKeyPool.h"
+
+@interface MKPrivateKeyPool () {
+    
+    os_unfair_lock _lock;
+    NSMutableDictionary<NSString *, NSMutableArray<id<MKPrivateKey>> *> *_keys;
+    NSMutableDictionary<NSString *, NSNumber *> *_watermarks;
+    NSMutableSet<NSString *> *_refilling;
+    
+    NSUInteger _hits;
+    NSUInteger _misses;
+    NSUInteger _generated;
+    NSUInteger _failures;
+    NSTimeInterval _elapsed;  // total time spent generating
+    
+    dispatch_queue_t _queue;
+}
+
+@end
+
+@implementation MKPrivateKeyPool
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _keys = [[NSMutableDictionary alloc] init];
+        _watermarks = [[NSMutableDictionary alloc] init];
+        _refilling = [[NSMutableSet alloc] init];
+        _hits = 0;
+        _misses = 0;
+        _generated = 0;
+        _failures = 0;
+        _elapsed = 0;
+        dispatch_queue_attr_t attr;
+        attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_BACKGROUND, 0);
+        _queue = dispatch_queue_create("chat.dim.crypto.keypool", attr);
+    }
+    return self;
+}
+
+- (NSUInteger)hits {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger cnt = _hits;
+    os_unfair_lock_unlock(&_lock);
+    return cnt;
+}
+
+- (NSUInteger)misses {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger cnt = _misses;
+    os_unfair_lock_unlock(&_lock);
+    return cnt;
+}
+
+- (NSUInteger)generated {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger cnt = _generated;
+    os_unfair_lock_unlock(&_lock);
+    return cnt;
+}
+
+- (NSUInteger)failures {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger cnt = _failures;
+    os_unfair_lock_unlock(&_lock);
+    return cnt;
+}
+
+- (double)generationRate {
+    os_unfair_lock_lock(&_lock);
+    double rate = _elapsed > 0 ? _generated / _elapsed : 0;
+    os_unfair_lock_unlock(&_lock);
+    return rate;
+}
+
+- (void)setWatermark:(NSUInteger)count forAlgorithm:(NSString *)algorithm {
+    os_unfair_lock_lock(&_lock);
+    [_watermarks setObject:@(count) forKey:algorithm];
+    NSMutableArray *keys = [_keys objectForKey:algorithm];
+    if (keys.count > count) {
+        [keys removeObjectsInRange:NSMakeRange(count, keys.count - count)];
+    }
+    os_unfair_lock_unlock(&_lock);
+    [self _refill:algorithm];
+}
+
+- (NSUInteger)watermarkForAlgorithm:(NSString *)algorithm {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger count = [[_watermarks objectForKey:algorithm] unsignedIntegerValue];
+    os_unfair_lock_unlock(&_lock);
+    return count;
+}
+
+- (NSUInteger)depthForAlgorithm:(NSString *)algorithm {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger count = [[_keys objectForKey:algorithm] count];
+    os_unfair_lock_unlock(&_lock);
+    return count;
+}
+
+- (nullable id<MKPrivateKey>)takeKey:(NSString *)algorithm {
+    id<MKPrivateKey> key = nil;
+    os_unfair_lock_lock(&_lock);
+    NSMutableArray<id<MKPrivateKey>> *keys = [_keys objectForKey:algorithm];
+    if (keys.count > 0) {
+        key = [keys lastObject];
+        [keys removeLastObject];
+        ++_hits;
+    } else if ([_watermarks objectForKey:algorithm]) {
+        ++_misses;
+    }
+    os_unfair_lock_unlock(&_lock);
+    [self _refill:algorithm];
+    return key;
+}
+
+- (void)drain {
+    os_unfair_lock_lock(&_lock);
+    [_keys removeAllObjects];
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (void)_refill:(NSString *)algorithm {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger watermark = [[_watermarks objectForKey:algorithm] unsignedIntegerValue];
+    BOOL needed = watermark > [[_keys objectForKey:algorithm] count] &&
+                  ![_refilling containsObject:algorithm];
+    if (needed) {
+        [_refilling addObject:algorithm];
+    }
+    os_unfair_lock_unlock(&_lock);
+    if (!needed) {
+        return;
+    }
+    dispatch_async(_queue, ^{
+        id<MKPrivateKeyHelper> helper = [MKCryptoExtensions sharedInstance].privateHelper;
+        id<MKPrivateKey> key;
+        CFAbsoluteTime start;
+        NSTimeInterval cost;
+        BOOL full = NO;
+        while (!full) {
+            @autoreleasepool {
+                start = CFAbsoluteTimeGetCurrent();
+                key = [helper generatePrivateKey:algorithm];
+                cost = CFAbsoluteTimeGetCurrent() - start;
+            }
+            os_unfair_lock_lock(&self->_lock);
+            NSUInteger limit = [[self->_watermarks objectForKey:algorithm] unsignedIntegerValue];
+            NSMutableArray *keys = [self->_keys objectForKey:algorithm];
+            if (!keys) {
+                keys = [[NSMutableArray alloc] initWithCapacity:limit];
+                [self->_keys setObject:keys forKey:algorithm];
+            }
+            if (!key) {
+                // algorithm not supported
+                self->_failures += 1;
+                full = YES;
+            } else {
+                self->_generated += 1;
+                self->_elapsed += cost;
+                if (keys.count < limit) {
+                    [keys addObject:key];
+                }
+                full = keys.count >= limit;
+            }
+            if (full) {
+                [self->_refilling removeObject:algorithm];
+            }
+            os_unfair_lock_unlock(&self->_lock);
+        }
+    });
+}
+
+@end
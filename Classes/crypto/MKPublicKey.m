@@ -51,5 +51,17 @@ void MKPublicKeySetFactory(NSString *algorithm, id<MKPublicKeyFactory> factory)
 
 id<MKPublicKey> MKPublicKeyParse(id key) {
     MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
-    return [ext.publicHelper parsePublicKey:key];
+    MKLRUCache<NSData *, id<MKPublicKey>> *cache = ext.publicKeyCache;
+    NSData *digest = cache ? MKCryptoKeyCacheKey(key) : nil;
+    if (!digest) {
+        return [ext.publicHelper parsePublicKey:key];
+    }
+    id<MKPublicKey> res = [cache objectForKey:digest];
+    if (!res) {
+        res = [ext.publicHelper parsePublicKey:key];
+        if (res) {
+            [cache setObject:res forKey:digest];
+        }
+    }
+    return res;
 }
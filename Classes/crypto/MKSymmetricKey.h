@@ -39,6 +39,16 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ *  Cipher params in a fixed struct, instead of the 'extra' dictionary
+ */
+typedef struct {
+    UInt8 iv[16];
+    UInt8 ivLength;
+    UInt8 tag[32];
+    UInt8 tagLength;
+} MKCipherParams;
+
 /*
  *  Symmetric Cryptography Key
  *  ~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -52,6 +62,43 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @protocol MKSymmetricKey <MKEncryptKey, MKDecryptKey>
 
+@optional
+
+/**
+ *  Build cipher state (e.g. expand AES key schedule) ahead of use;
+ *  called before the key is put into the session key cache, which
+ *  returns copies, so 'copyWithZone:' should keep the state
+ */
+- (void)prepare;
+
+/**
+ *  Encrypt into caller's buffer (no allocation)
+ *
+ * @param plaintext - plain bytes
+ * @param length    - plain length
+ * @param output    - output buffer, can be the same as plaintext (in place)
+ * @param capacity  - output buffer size
+ * @param params    - to store IV and tag
+ * @return ciphertext length; -1 on error (or buffer too small)
+ */
+- (NSInteger)encrypt:(const void *)plaintext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(MKCipherParams *)params;
+
+/**
+ *  Decrypt into caller's buffer (no allocation)
+ *
+ * @param ciphertext - encrypted bytes
+ * @param length     - encrypted length
+ * @param output     - output buffer, can be the same as ciphertext (in place)
+ * @param capacity   - output buffer size
+ * @param params     - IV and tag
+ * @return plaintext length; -1 on error (or buffer too small)
+ */
+- (NSInteger)decrypt:(const void *)ciphertext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(const MKCipherParams *)params;
+
 @end
 
 #pragma mark - Key Factory
@@ -88,6 +135,22 @@ _Nullable id<MKSymmetricKey> MKSymmetricKeyGenerate(NSString *algorithm);
 
 _Nullable id<MKSymmetricKey> MKSymmetricKeyParse(_Nullable id key);
 
+/**
+ *  Encrypt/decrypt into caller's buffer
+ *  (keys without buffer methods go through 'encrypt:extra:'/'decrypt:params:'
+ *   with 'IV' and 'tag' in the dictionary, which allocates; encrypting
+ *   fails with -1 if they are longer than the struct can hold)
+ */
+NSInteger MKSymmetricKeyEncryptInto(id<MKSymmetricKey> key,
+                                    const void *plaintext, NSUInteger length,
+                                    void *output, NSUInteger capacity,
+                                    MKCipherParams *params);
+
+NSInteger MKSymmetricKeyDecryptInto(id<MKSymmetricKey> key,
+                                    const void *ciphertext, NSUInteger length,
+                                    void *output, NSUInteger capacity,
+                                    const MKCipherParams *params);
+
 #ifdef __cplusplus
 } /* end of extern "C" */
 #endif
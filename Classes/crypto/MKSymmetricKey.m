@@ -36,6 +36,7 @@
 //
 
 #import "MKCryptoHelpers.h"
+#import "MKDataCoder.h"
 
 #import "MKSymmetricKey.h"
 
@@ -56,5 +57,96 @@ id<MKSymmetricKey> MKSymmetricKeyGenerate(NSString *algorithm) {
 
 id<MKSymmetricKey> MKSymmetricKeyParse(id key) {
     MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
-    return [ext.symmetricHelper parseSymmetricKey:key];
+    MKLRUCache<NSData *, id<MKSymmetricKey>> *cache = ext.symmetricKeyCache;
+    NSData *digest = cache ? MKCryptoKeyCacheKey(key) : nil;
+    if (!digest) {
+        return [ext.symmetricHelper parseSymmetricKey:key];
+    }
+    id<MKSymmetricKey> res = [cache objectForKey:digest];
+    if (!res) {
+        res = [ext.symmetricHelper parseSymmetricKey:key];
+        if (!res) {
+            return nil;
+        }
+        if ([res respondsToSelector:@selector(prepare)]) {
+            [res prepare];
+        }
+        [cache setObject:res forKey:digest];
+    }
+    // callers may modify the key, never share the cached one
+    return [res copy];
+}
+
+// NO when the value does not fit in the struct
+static inline BOOL set_param(MKCipherParams *params, NSString *name, id value) {
+    NSData *data = [value isKindOfClass:[NSString class]] ? MKBase64Decode(value) : nil;
+    NSUInteger length = data.length;
+    if ([name isEqualToString:@"IV"]) {
+        if (length > sizeof(params->iv)) {
+            return NO;
+        } else if (length > 0) {
+            memcpy(params->iv, data.bytes, length);
+        }
+        params->ivLength = length;
+    } else {
+        if (length > sizeof(params->tag)) {
+            return NO;
+        } else if (length > 0) {
+            memcpy(params->tag, data.bytes, length);
+        }
+        params->tagLength = length;
+    }
+    return YES;
+}
+
+static inline NSData *get_param(const UInt8 *bytes, UInt8 length) {
+    return length > 0 ? [[NSData alloc] initWithBytes:bytes length:length] : nil;
+}
+
+NSInteger MKSymmetricKeyEncryptInto(id<MKSymmetricKey> key,
+                                    const void *plaintext, NSUInteger length,
+                                    void *output, NSUInteger capacity,
+                                    MKCipherParams *params) {
+    if ([key respondsToSelector:@selector(encrypt:length:output:capacity:params:)]) {
+        return [key encrypt:plaintext length:length output:output capacity:capacity params:params];
+    }
+    NSMutableDictionary *extra = [[NSMutableDictionary alloc] initWithCapacity:2];
+    NSData *data = [[NSData alloc] initWithBytesNoCopy:(void *)plaintext length:length freeWhenDone:NO];
+    NSData *ciphertext = [key encrypt:data extra:extra];
+    if (!ciphertext || ciphertext.length > capacity) {
+        return -1;
+    }
+    memset(params, 0, sizeof(MKCipherParams));
+    if (!set_param(params, @"IV", [extra objectForKey:@"IV"]) ||
+        !set_param(params, @"tag", [extra objectForKey:@"tag"])) {
+        // cannot be carried by the struct
+        return -1;
+    }
+    memcpy(output, ciphertext.bytes, ciphertext.length);
+    return ciphertext.length;
+}
+
+NSInteger MKSymmetricKeyDecryptInto(id<MKSymmetricKey> key,
+                                    const void *ciphertext, NSUInteger length,
+                                    void *output, NSUInteger capacity,
+                                    const MKCipherParams *params) {
+    if ([key respondsToSelector:@selector(decrypt:length:output:capacity:params:)]) {
+        return [key decrypt:ciphertext length:length output:output capacity:capacity params:params];
+    }
+    NSMutableDictionary *extra = [[NSMutableDictionary alloc] initWithCapacity:2];
+    NSData *iv = get_param(params->iv, params->ivLength);
+    NSData *tag = get_param(params->tag, params->tagLength);
+    if (iv) {
+        [extra setObject:MKBase64Encode(iv) forKey:@"IV"];
+    }
+    if (tag) {
+        [extra setObject:MKBase64Encode(tag) forKey:@"tag"];
+    }
+    NSData *data = [[NSData alloc] initWithBytesNoCopy:(void *)ciphertext length:length freeWhenDone:NO];
+    NSData *plaintext = [key decrypt:data params:extra];
+    if (!plaintext || plaintext.length > capacity) {
+        return -1;
+    }
+    memcpy(output, plaintext.bytes, plaintext.length);
+    return plaintext.length;
 }
@@ -0,0 +1,94 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKCanonicalJSON.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <MingKeMing/MKDataParser.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ *  Canonical JsON Coder
+ *  ~~~~~~~~~~~~~~~~~~~~
+ *  Deterministic output for signing and hashing:
+ *
+ *  1. keys sorted by UTF-16 code units;
+ *  2. no whitespace;
+ *  3. integers in decimal, floats in the shortest round-trip form,
+ *     always with the C locale;
+ *  4. strings only escape '"', '\' and control chars,
+ *     other chars stay in UTF-8 (unpaired surrogates as '\uXXXX');
+ *  5. non-string keys, NaN/Infinity and unknown values are rejected:
+ *     'encode:appendTo:' returns NO for them, while 'encode:' and
+ *     'encodeData:' hand them to MKJSON, which reports the error.
+ *
+ *  Select it for all maps with:
+ *      [MKJSONMap setCoder:[[MKCanonicalMapCoder alloc] init]];
+ *  or per call with 'MKJSONMap encodeCanonicalData:';
+ *  decoding is delegated to MKJSON.
+ */
+@interface MKCanonicalMapCoder : NSObject <MKMapCoder>
+
+@end
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Append canonical JsON of the object to the buffer
+ *
+ * @param object - Map, List, String, Number, ...
+ * @param buffer - output buffer
+ * @return NO if the object cannot be encoded (buffer unchanged)
+ */
+BOOL MKCanonicalJSONAppend(id object, NSMutableData *buffer);
+
+/**
+ *  Append JsON of the object to the buffer, same writer as above
+ *  but keys in dictionary order, so nothing is allocated except
+ *  when the buffer grows (used by the default MKJSON coder)
+ *
+ * @param object - Map, List, String, Number, ...
+ * @param buffer - output buffer
+ * @return NO if the object cannot be encoded (buffer unchanged)
+ */
+BOOL MKJSONAppend(id object, NSMutableData *buffer);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,332 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKCanonicalJSON.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <xlocale.h>
+
+#import "MKDictionary.h"
+#import "MKString.h"
+
+#import "MKCanonicalJSON.h"
+
+#define MKCanonicalBufferCapacity  4096
+
+static NSString *kScratchBufferKey = @"MKCanonicalMapCoder.buffer";
+
+// reusable buffer for current thread
+static NSMutableData *scratch_buffer(void) {
+    NSMutableDictionary *info = [[NSThread currentThread] threadDictionary];
+    NSMutableData *buffer = [info objectForKey:kScratchBufferKey];
+    if (!buffer) {
+        buffer = [[NSMutableData alloc] initWithCapacity:MKCanonicalBufferCapacity];
+        [info setObject:buffer forKey:kScratchBufferKey];
+    }
+    [buffer setLength:0];
+    return buffer;
+}
+
+static inline void append_str(NSMutableData *buffer, const char *str) {
+    [buffer appendBytes:str length:strlen(str)];
+}
+
+#define MKJSONStringChunk  256
+
+static void append_string(NSMutableData *buffer, NSString *string) {
+    static const char *hex = "0123456789abcdef";
+    // UTF-16 units in, at most 6 bytes out for each ('\uXXXX')
+    unichar chars[MKJSONStringChunk];
+    UInt8 out[MKJSONStringChunk * 6];
+    NSUInteger length = string.length;
+    NSUInteger pos = 0, cnt, index, size;
+    unichar ch;
+    UInt32 code;
+    [buffer appendBytes:"\"" length:1];
+    while (pos < length) {
+        cnt = MIN(length - pos, MKJSONStringChunk);
+        [string getCharacters:chars range:NSMakeRange(pos, cnt)];
+        if (pos + cnt < length && CFStringIsSurrogateHighCharacter(chars[cnt - 1])) {
+            // keep the pair together for the next chunk
+            --cnt;
+        }
+        for (index = 0, size = 0; index < cnt; ++index) {
+            ch = chars[index];
+            if (ch >= 0x20 && ch < 0x80 && ch != '"' && ch != '\\') {
+                out[size++] = ch;
+            } else if (ch < 0x80) {
+                out[size++] = '\\';
+                switch (ch) {
+                    case '"':  out[size++] = '"';  break;
+                    case '\\': out[size++] = '\\'; break;
+                    case '\b': out[size++] = 'b';  break;
+                    case '\f': out[size++] = 'f';  break;
+                    case '\n': out[size++] = 'n';  break;
+                    case '\r': out[size++] = 'r';  break;
+                    case '\t': out[size++] = 't';  break;
+                    default:
+                        memcpy(out + size, "u00", 3);
+                        out[size + 3] = hex[ch >> 4];
+                        out[size + 4] = hex[ch & 0x0F];
+                        size += 5;
+                        break;
+                }
+            } else if (ch < 0x800) {
+                out[size++] = 0xC0 | (ch >> 6);
+                out[size++] = 0x80 | (ch & 0x3F);
+            } else if (CFStringIsSurrogateHighCharacter(ch) && index + 1 < cnt &&
+                       CFStringIsSurrogateLowCharacter(chars[index + 1])) {
+                code = CFStringGetLongCharacterForSurrogatePair(ch, chars[++index]);
+                out[size++] = 0xF0 | (code >> 18);
+                out[size++] = 0x80 | ((code >> 12) & 0x3F);
+                out[size++] = 0x80 | ((code >> 6) & 0x3F);
+                out[size++] = 0x80 | (code & 0x3F);
+            } else if (CFStringIsSurrogateHighCharacter(ch) || CFStringIsSurrogateLowCharacter(ch)) {
+                // unpaired surrogate, escape the code unit
+                memcpy(out + size, "\\u", 2);
+                out[size + 2] = hex[ch >> 12];
+                out[size + 3] = hex[(ch >> 8) & 0x0F];
+                out[size + 4] = hex[(ch >> 4) & 0x0F];
+                out[size + 5] = hex[ch & 0x0F];
+                size += 6;
+            } else {
+                out[size++] = 0xE0 | (ch >> 12);
+                out[size++] = 0x80 | ((ch >> 6) & 0x3F);
+                out[size++] = 0x80 | (ch & 0x3F);
+            }
+        }
+        [buffer appendBytes:out length:size];
+        pos += cnt;
+    }
+    [buffer appendBytes:"\"" length:1];
+}
+
+static BOOL append_double(NSMutableData *buffer, double value) {
+    char str[32];
+    if (isnan(value) || isinf(value)) {
+        // not a JsON number
+        return NO;
+    }
+    if (value == trunc(value) && fabs(value) < 1e15) {
+        // integral, '-0' as '0'
+        snprintf(str, sizeof(str), "%lld", (long long)value);
+        append_str(buffer, str);
+        return YES;
+    }
+    // shortest form which parses back to the same value
+    for (int precision = 1; precision <= 17; ++precision) {
+        snprintf_l(str, sizeof(str), NULL, "%.*g", precision, value);
+        if (strtod_l(str, NULL, NULL) == value) {
+            break;
+        }
+    }
+    append_str(buffer, str);
+    return YES;
+}
+
+static BOOL append_number(NSMutableData *buffer, NSNumber *number) {
+    char str[32];
+    if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+        append_str(buffer, [number boolValue] ? "true" : "false");
+        return YES;
+    }
+    switch (*[number objCType]) {
+        case 'f':
+        case 'd':
+            return append_double(buffer, [number doubleValue]);
+        case 'Q':
+        case 'L':
+        case 'I':
+            snprintf(str, sizeof(str), "%llu", [number unsignedLongLongValue]);
+            break;
+        default:
+            snprintf(str, sizeof(str), "%lld", [number longLongValue]);
+            break;
+    }
+    append_str(buffer, str);
+    return YES;
+}
+
+static NSComparisonResult compare_keys(NSString *key1, NSString *key2) {
+    // UTF-16 code units
+    return [key1 compare:key2 options:NSLiteralSearch];
+}
+
+static BOOL append_object(NSMutableData *buffer, id object, BOOL sorted);
+
+// keys sorted, for canonical output
+static BOOL append_sorted_map(NSMutableData *buffer, NSDictionary *dict) {
+    NSArray *keys = [dict allKeys];
+    for (id key in keys) {
+        if (![key isKindOfClass:[NSString class]]) {
+            // JsON keys must be strings
+            return NO;
+        }
+    }
+    keys = [keys sortedArrayUsingComparator:^NSComparisonResult(id k1, id k2) {
+        return compare_keys(k1, k2);
+    }];
+    BOOL first = YES;
+    [buffer appendBytes:"{" length:1];
+    for (NSString *key in keys) {
+        if (!first) {
+            [buffer appendBytes:"," length:1];
+        }
+        first = NO;
+        append_string(buffer, key);
+        [buffer appendBytes:":" length:1];
+        if (!append_object(buffer, [dict objectForKey:key], YES)) {
+            return NO;
+        }
+    }
+    [buffer appendBytes:"}" length:1];
+    return YES;
+}
+
+// keys in dictionary order, nothing allocated
+static BOOL append_map(NSMutableData *buffer, NSDictionary *dict) {
+    BOOL first = YES;
+    [buffer appendBytes:"{" length:1];
+    for (id key in dict) {
+        if (![key isKindOfClass:[NSString class]]) {
+            // JsON keys must be strings
+            return NO;
+        }
+        if (!first) {
+            [buffer appendBytes:"," length:1];
+        }
+        first = NO;
+        append_string(buffer, key);
+        [buffer appendBytes:":" length:1];
+        if (!append_object(buffer, [dict objectForKey:key], NO)) {
+            return NO;
+        }
+    }
+    [buffer appendBytes:"}" length:1];
+    return YES;
+}
+
+static BOOL append_object(NSMutableData *buffer, id object, BOOL sorted) {
+    if (!object || object == [NSNull null]) {
+        append_str(buffer, "null");
+    } else if ([object isKindOfClass:[NSString class]]) {
+        append_string(buffer, object);
+    } else if ([object isKindOfClass:[NSNumber class]]) {
+        return append_number(buffer, object);
+    } else if ([object isKindOfClass:[NSDictionary class]]) {
+        return sorted ? append_sorted_map(buffer, object) : append_map(buffer, object);
+    } else if ([object isKindOfClass:[NSArray class]]) {
+        BOOL first = YES;
+        [buffer appendBytes:"[" length:1];
+        for (id item in object) {
+            if (!first) {
+                [buffer appendBytes:"," length:1];
+            }
+            first = NO;
+            if (!append_object(buffer, item, sorted)) {
+                return NO;
+            }
+        }
+        [buffer appendBytes:"]" length:1];
+    } else if ([object conformsToProtocol:@protocol(MKDictionary)]) {
+        return append_object(buffer, [object dictionary], sorted);
+    } else if ([object conformsToProtocol:@protocol(MKString)]) {
+        append_string(buffer, [object string]);
+    } else {
+        // unknown value
+        return NO;
+    }
+    return YES;
+}
+
+static BOOL append_json(id object, NSMutableData *buffer, BOOL sorted) {
+    NSUInteger length = buffer.length;
+    if (append_object(buffer, object, sorted)) {
+        return YES;
+    }
+    // roll back the partial output
+    [buffer setLength:length];
+    return NO;
+}
+
+BOOL MKCanonicalJSONAppend(id object, NSMutableData *buffer) {
+    return append_json(object, buffer, YES);
+}
+
+BOOL MKJSONAppend(id object, NSMutableData *buffer) {
+    return append_json(object, buffer, NO);
+}
+
+@implementation MKCanonicalMapCoder
+
+// Override
+- (BOOL)encode:(NSDictionary *)object appendTo:(NSMutableData *)buffer {
+    return MKCanonicalJSONAppend(object, buffer);
+}
+
+// Override
+- (NSString *)encode:(NSDictionary *)object {
+    NSMutableData *buffer = scratch_buffer();
+    NSString *json = nil;
+    if (MKCanonicalJSONAppend(object, buffer)) {
+        json = [[NSString alloc] initWithData:buffer encoding:NSUTF8StringEncoding];
+    }
+    [buffer setLength:0];
+    // not a JsON map, let the plain coder report it
+    return json ? json : [MKJSON encode:object];
+}
+
+// Override
+- (nullable NSDictionary *)decode:(NSString *)string {
+    return [MKJSON decode:string];
+}
+
+// Override
+- (NSData *)encodeData:(NSDictionary *)object {
+    NSMutableData *buffer = scratch_buffer();
+    NSData *json = nil;
+    if (MKCanonicalJSONAppend(object, buffer)) {
+        json = [[NSData alloc] initWithData:buffer];
+    }
+    [buffer setLength:0];
+    // not a JsON map, let the plain coder report it
+    return json ? json : [MKJSON encodeData:object];
+}
+
+// Override
+- (nullable NSDictionary *)decodeData:(NSData *)utf8 {
+    return [MKJSON decodeData:utf8];
+}
+
+@end
@@ -93,6 +93,36 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable id)decode:(NSString *)string;
 
+@optional
+
+/**
+ *  Encode Map/List object to UTF-8 bytes directly,
+ *  without building an intermediate string
+ *
+ * @param object - Map or List
+ * @return serialized data (UTF-8)
+ */
+- (NSData *)encodeData:(id)object;
+
+/**
+ *  Decode Map/List object from UTF-8 bytes directly,
+ *  without building an intermediate string
+ *
+ * @param utf8 - serialized data (UTF-8)
+ * @return Map or List
+ */
+- (nullable id)decodeData:(NSData *)utf8;
+
+/**
+ *  Append serialized UTF-8 bytes to the buffer,
+ *  so the caller can reuse one buffer for many objects
+ *
+ * @param object - Map or List
+ * @param buffer - output buffer
+ * @return NO if the object cannot be encoded (buffer unchanged)
+ */
+- (BOOL)encode:(id)object appendTo:(NSMutableData *)buffer;
+
 @end
 
 /**
@@ -104,12 +134,46 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable NSDictionary *)decode:(NSString *)string;
 
+@optional
+
+- (NSData *)encodeData:(NSDictionary *)object;
+
+- (nullable NSDictionary *)decodeData:(NSData *)utf8;
+
+- (BOOL)encode:(NSDictionary *)object appendTo:(NSMutableData *)buffer;
+
 @end
 
 @interface MKMapCoder : NSObject <MKMapCoder>
 
 @end
 
+/**
+ *  Default UTF-8 coder
+ *
+ *      encode: zero-copy for strings with 8-bit (ASCII) storage,
+ *              ASCII fast path before transcoding the rest,
+ *              unpaired surrogates become '?';
+ *      decode: vectorized ASCII scan, then validate and transcode
+ *              the rest in one pass, invalid bytes return nil.
+ */
+@interface MKUTF8Coder : NSObject <MKStringCoder>
+
+@end
+
+/**
+ *  Default JsON coder (NSJSONSerialization)
+ *
+ *      encodeData/decodeData work on UTF-8 bytes directly,
+ *      wrappers (MKDictionary, MKString) are unwrapped before encoding;
+ *      encode:appendTo: writes into the caller's buffer (MKJSONAppend),
+ *      allocating nothing once the buffer is large enough;
+ *      used by MKJSON when no other coder is set.
+ */
+@interface MKJSONCoder : NSObject <MKObjectCoder>
+
+@end
+
 #pragma mark -
 
 @interface MKUTF8 : NSObject
@@ -130,6 +194,31 @@ NS_ASSUME_NONNULL_BEGIN
 + (NSString *)encode:(id)object;
 + (nullable id)decode:(NSString *)json;
 
+/**
+ *  Encode/decode with UTF-8 bytes,
+ *  fallback to string + MKUTF8 when the coder has no data methods
+ */
++ (NSData *)encodeData:(id)object;
++ (nullable id)decodeData:(NSData *)utf8;
+
+/**
+ *  Append serialized UTF-8 bytes to the buffer
+ *
+ * @param object - Map or List
+ * @param buffer - output buffer, e.g. [MKJSON threadBuffer]
+ * @return NO if the object cannot be encoded (buffer unchanged)
+ */
++ (BOOL)encode:(id)object appendTo:(NSMutableData *)buffer;
+
+/**
+ *  Reusable output buffer of current thread,
+ *  it is reset (length = 0) on each call but keeps its capacity.
+ *
+ *  NOTICE: one user at a time, copy the bytes out (or send them)
+ *          before asking for it again on the same thread.
+ */
++ (NSMutableData *)threadBuffer;
+
 @end
 
 @interface MKJSONMap : NSObject
@@ -140,6 +229,29 @@ NS_ASSUME_NONNULL_BEGIN
 + (NSString *)encode:(NSDictionary *)object;
 + (nullable NSDictionary *)decode:(NSString *)json;
 
++ (NSData *)encodeData:(NSDictionary *)object;
++ (nullable NSDictionary *)decodeData:(NSData *)utf8;
+
++ (BOOL)encode:(NSDictionary *)object appendTo:(NSMutableData *)buffer;
+
+/**
+ *  Canonical JsON (sorted keys, no whitespace, fixed number format)
+ *  for signing and hashing, whichever coder is set above
+ *
+ * @param object - Map
+ * @return nil if the map cannot be encoded
+ */
++ (nullable NSData *)encodeCanonicalData:(NSDictionary *)object;
+
+/**
+ *  Append canonical JsON of the map to the buffer
+ *
+ * @param object - Map
+ * @param buffer - output buffer
+ * @return NO if the map cannot be encoded (buffer unchanged)
+ */
++ (BOOL)encodeCanonical:(NSDictionary *)object appendTo:(NSMutableData *)buffer;
+
 @end
 
 #define MKUTF8Encode(string) [MKUTF8 encode:(string)]
@@ -151,4 +263,13 @@ NS_ASSUME_NONNULL_BEGIN
 #define MKJsonMapEncode(object) [MKJSONMap encode:(object)]
 #define MKJsonMapDecode(string) [MKJSONMap decode:(string)]
 
+#define MKJsonEncodeData(object)   [MKJSON encodeData:(object)]
+#define MKJsonDecodeData(data)     [MKJSON decodeData:(data)]
+
+#define MKJsonMapEncodeData(object) [MKJSONMap encodeData:(object)]
+#define MKJsonMapDecodeData(data)   [MKJSONMap decodeData:(data)]
+
+#define MKJsonEncodeTo(object, buffer)    [MKJSON encode:(object) appendTo:(buffer)]
+#define MKJsonMapEncodeTo(object, buffer) [MKJSONMap encode:(object) appendTo:(buffer)]
+
 NS_ASSUME_NONNULL_END
@@ -35,8 +35,239 @@
 //  Copyright © 2020 DIM Group. All rights reserved.
 //
 
+#if defined(__SSE2__)
+#import <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#import <arm_neon.h>
+#endif
+
+#import "MKWrapper.h"
+#import "MKCanonicalJSON.h"
+
 #import "MKDataParser.h"
 
+// length of the leading ASCII run
+static NSUInteger ascii_prefix(const UInt8 *bytes, NSUInteger length) {
+    NSUInteger pos = 0;
+#if defined(__SSE2__)
+    for (; pos + 16 <= length; pos += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(bytes + pos));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break;
+        }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; pos + 16 <= length; pos += 16) {
+        uint8x16_t chunk = vld1q_u8(bytes + pos);
+        if (vmaxvq_u8(chunk) >= 0x80) {
+            break;
+        }
+    }
+#endif
+    uint64_t word;
+    for (; pos + 8 <= length; pos += 8) {
+        memcpy(&word, bytes + pos, 8);
+        if (word & 0x8080808080808080ULL) {
+            break;
+        }
+    }
+    while (pos < length && bytes[pos] < 0x80) {
+        ++pos;
+    }
+    return pos;
+}
+
+static inline BOOL is_continuation(UInt8 ch) {
+    return (ch & 0xC0) == 0x80;
+}
+
+// RFC 3629: no overlong forms, no surrogates, max U+10FFFF;
+// validate and transcode to UTF-16 in one pass,
+// returns count of chars, or NSNotFound for invalid bytes
+static NSUInteger decode_utf8(const UInt8 *bytes, NSUInteger length, unichar *chars) {
+    NSUInteger pos = 0, count = 0, ascii;
+    UInt8 ch, next;
+    UInt32 code;
+    while (pos < length) {
+        ascii = ascii_prefix(bytes + pos, length - pos);
+        for (; ascii > 0; --ascii) {
+            chars[count++] = bytes[pos++];
+        }
+        if (pos >= length) {
+            break;
+        }
+        ch = bytes[pos];
+        if (ch < 0xC2) {
+            // continuation byte, or overlong 2-byte form
+            return NSNotFound;
+        } else if (ch < 0xE0) {
+            if (pos + 1 >= length || !is_continuation(bytes[pos + 1])) {
+                return NSNotFound;
+            }
+            chars[count++] = ((ch & 0x1F) << 6) | (bytes[pos + 1] & 0x3F);
+            pos += 2;
+        } else if (ch < 0xF0) {
+            if (pos + 2 >= length) {
+                return NSNotFound;
+            }
+            next = bytes[pos + 1];
+            if ((ch == 0xE0 && next < 0xA0) ||  // overlong
+                (ch == 0xED && next > 0x9F) ||  // surrogates
+                !is_continuation(next) || !is_continuation(bytes[pos + 2])) {
+                return NSNotFound;
+            }
+            chars[count++] = ((ch & 0x0F) << 12) | ((next & 0x3F) << 6) | (bytes[pos + 2] & 0x3F);
+            pos += 3;
+        } else if (ch < 0xF5) {
+            if (pos + 3 >= length) {
+                return NSNotFound;
+            }
+            next = bytes[pos + 1];
+            if ((ch == 0xF0 && next < 0x90) ||  // overlong
+                (ch == 0xF4 && next > 0x8F) ||  // > U+10FFFF
+                !is_continuation(next) || !is_continuation(bytes[pos + 2]) ||
+                !is_continuation(bytes[pos + 3])) {
+                return NSNotFound;
+            }
+            code = ((ch & 0x07) << 18) | ((next & 0x3F) << 12) |
+                   ((bytes[pos + 2] & 0x3F) << 6) | (bytes[pos + 3] & 0x3F);
+            // surrogate pair
+            code -= 0x10000;
+            chars[count++] = 0xD800 | (code >> 10);
+            chars[count++] = 0xDC00 | (code & 0x3FF);
+            pos += 4;
+        } else {
+            return NSNotFound;
+        }
+    }
+    return count;
+}
+
+@implementation MKUTF8Coder
+
+- (NSData *)encode:(NSString *)string {
+    // immutable, so the storage can be shared
+    string = [string copy];
+    CFStringRef str = (__bridge CFStringRef)string;
+    CFIndex length = CFStringGetLength(str);
+    const char *cstr = CFStringGetCStringPtr(str, kCFStringEncodingUTF8);
+    if (cstr) {
+        // 8-bit (ASCII) storage, zero-copy
+        return [[NSData alloc] initWithBytesNoCopy:(void *)cstr
+                                            length:length
+                                       deallocator:^(void *bytes, NSUInteger len) {
+            // keep the string alive until the data is released
+            (void)string;
+        }];
+    }
+    // ASCII prefix
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:length];
+    CFIndex used = 0;
+    CFIndex cnt = CFStringGetBytes(str, CFRangeMake(0, length),
+                                   kCFStringEncodingASCII, 0, false,
+                                   data.mutableBytes, length, &used);
+    if (cnt == length) {
+        return data;
+    }
+    // transcode the rest, unpaired surrogates as '?'
+    CFRange rest = CFRangeMake(cnt, length - cnt);
+    CFIndex size = 0;
+    CFStringGetBytes(str, rest, kCFStringEncodingUTF8, '?', false, NULL, 0, &size);
+    [data setLength:(used + size)];
+    UInt8 *buffer = (UInt8 *)data.mutableBytes + used;
+    cnt = CFStringGetBytes(str, rest, kCFStringEncodingUTF8, '?', false, buffer, size, &size);
+    if (cnt != rest.length) {
+        return [string dataUsingEncoding:NSUTF8StringEncoding allowLossyConversion:YES];
+    }
+    return data;
+}
+
+- (nullable NSString *)decode:(NSData *)data {
+    const UInt8 *bytes = data.bytes;
+    NSUInteger length = data.length;
+    NSUInteger ascii = ascii_prefix(bytes, length);
+    if (ascii == length) {
+        // pure ASCII, stored as 8-bit string
+        return [[NSString alloc] initWithBytes:bytes
+                                        length:length
+                                      encoding:NSASCIIStringEncoding];
+    }
+    // one UTF-16 unit per byte at most
+    unichar *chars = malloc(length * sizeof(unichar));
+    if (!chars) {
+        return nil;
+    }
+    for (NSUInteger pos = 0; pos < ascii; ++pos) {
+        chars[pos] = bytes[pos];
+    }
+    NSUInteger count = decode_utf8(bytes + ascii, length - ascii, chars + ascii);
+    if (count == NSNotFound) {
+        free(chars);
+        return nil;
+    }
+    count += ascii;
+    if (count < length / 2) {
+        // mostly multi-byte chars, give back the spare room
+        unichar *smaller = realloc(chars, count * sizeof(unichar));
+        if (smaller) {
+            chars = smaller;
+        }
+    }
+    // validated already, no second pass by NSString
+    return [[NSString alloc] initWithCharactersNoCopy:chars
+                                               length:count
+                                         freeWhenDone:YES];
+}
+
+@end
+
+@implementation MKJSONCoder
+
+// Override
+- (NSString *)encode:(id)object {
+    NSData *json = [self encodeData:object];
+    return [[NSString alloc] initWithData:json encoding:NSUTF8StringEncoding];
+}
+
+// Override
+- (nullable id)decode:(NSString *)string {
+    NSData *json = [string dataUsingEncoding:NSUTF8StringEncoding];
+    return json ? [self decodeData:json] : nil;
+}
+
+// Override
+- (NSData *)encodeData:(id)object {
+    object = MKUnwrap(object);
+    if (![NSJSONSerialization isValidJSONObject:object]) {
+        NSAssert(false, @"JsON value error: %@", object);
+        return [NSData data];
+    }
+    NSError *error = nil;
+    NSData *json = [NSJSONSerialization dataWithJSONObject:object
+                                                   options:0
+                                                     error:&error];
+    NSAssert(!error, @"JsON encode error: %@", error);
+    return json ? json : [NSData data];
+}
+
+// Override
+- (nullable id)decodeData:(NSData *)utf8 {
+    NSError *error = nil;
+    id object = [NSJSONSerialization JSONObjectWithData:utf8
+                                                options:NSJSONReadingAllowFragments
+                                                  error:&error];
+    // malformed input is reported by nil
+    return error ? nil : object;
+}
+
+// Override
+- (BOOL)encode:(id)object appendTo:(NSMutableData *)buffer {
+    // written into the buffer directly, no intermediate data
+    return MKJSONAppend(object, buffer);
+}
+
+@end
+
 @implementation MKUTF8
 
 static id<MKStringCoder> s_utf8 = nil;
@@ -46,17 +277,25 @@ static id<MKStringCoder> s_utf8 = nil;
 }
 
 + (id<MKStringCoder>)getCoder {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        if (!s_utf8) {
+            s_utf8 = [[MKUTF8Coder alloc] init];
+        }
+    });
     return s_utf8;
 }
 
 + (NSData *)encode:(id)object {
-    NSAssert(s_utf8, @"UTF-8 coder not set");
-    return [s_utf8 encode:object];
+    id<MKStringCoder> coder = [self getCoder];
+    NSAssert(coder, @"UTF-8 coder not set");
+    return [coder encode:object];
 }
 
 + (nullable id)decode:(NSData *)bytes {
-    NSAssert(s_utf8, @"UTF-8 coder not set");
-    return [s_utf8 decode:bytes];
+    id<MKStringCoder> coder = [self getCoder];
+    NSAssert(coder, @"UTF-8 coder not set");
+    return [coder decode:bytes];
 }
 
 @end
@@ -70,17 +309,76 @@ static id<MKObjectCoder> s_json = nil;
 }
 
 + (id<MKObjectCoder>)getCoder {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        if (!s_json) {
+            s_json = [[MKJSONCoder alloc] init];
+        }
+    });
     return s_json;
 }
 
 + (NSString *)encode:(id)object {
-    NSAssert(s_json, @"JsON coder not set");
-    return [s_json encode:object];
+    id<MKObjectCoder> coder = [self getCoder];
+    NSAssert(coder, @"JsON coder not set");
+    return [coder encode:object];
 }
 
 + (nullable id)decode:(NSString *)json {
-    NSAssert(s_json, @"JsON coder not set");
-    return [s_json decode:json];
+    id<MKObjectCoder> coder = [self getCoder];
+    NSAssert(coder, @"JsON coder not set");
+    return [coder decode:json];
+}
+
++ (NSData *)encodeData:(id)object {
+    id<MKObjectCoder> coder = [self getCoder];
+    NSAssert(coder, @"JsON coder not set");
+    if ([coder respondsToSelector:@selector(encodeData:)]) {
+        return [coder encodeData:object];
+    }
+    NSString *json = [coder encode:object];
+    return [MKUTF8 encode:json];
+}
+
++ (nullable id)decodeData:(NSData *)utf8 {
+    id<MKObjectCoder> coder = [self getCoder];
+    NSAssert(coder, @"JsON coder not set");
+    if ([coder respondsToSelector:@selector(decodeData:)]) {
+        return [coder decodeData:utf8];
+    }
+    NSString *json = [MKUTF8 decode:utf8];
+    if (!json) {
+        return nil;
+    }
+    return [coder decode:json];
+}
+
++ (BOOL)encode:(id)object appendTo:(NSMutableData *)buffer {
+    id<MKObjectCoder> coder = [self getCoder];
+    NSAssert(coder, @"JsON coder not set");
+    if ([coder respondsToSelector:@selector(encode:appendTo:)]) {
+        return [coder encode:object appendTo:buffer];
+    }
+    NSData *json = [self encodeData:object];
+    if ([json length] == 0) {
+        return NO;
+    }
+    [buffer appendData:json];
+    return YES;
+}
+
+static NSString *kThreadBufferKey = @"MKJSON.buffer";
+
++ (NSMutableData *)threadBuffer {
+    NSMutableDictionary *info = [[NSThread currentThread] threadDictionary];
+    NSMutableData *buffer = [info objectForKey:kThreadBufferKey];
+    if (buffer) {
+        [buffer setLength:0];
+    } else {
+        buffer = [[NSMutableData alloc] initWithCapacity:4096];
+        [info setObject:buffer forKey:kThreadBufferKey];
+    }
+    return buffer;
 }
 
 @end
@@ -95,6 +393,18 @@ static id<MKObjectCoder> s_json = nil;
     return [MKJSON decode:string];
 }
 
+- (NSData *)encodeData:(NSDictionary *)object {
+    return [MKJSON encodeData:object];
+}
+
+- (nullable NSDictionary *)decodeData:(NSData *)utf8 {
+    return [MKJSON decodeData:utf8];
+}
+
+- (BOOL)encode:(NSDictionary *)object appendTo:(NSMutableData *)buffer {
+    return [MKJSON encode:object appendTo:buffer];
+}
+
 @end
 
 @implementation MKJSONMap
@@ -127,4 +437,53 @@ static id<MKMapCoder> s_json_map = nil;
     return [coder decode:json];
 }
 
++ (NSData *)encodeData:(NSDictionary *)object {
+    id<MKMapCoder> coder = [self getCoder];
+    NSAssert(coder, @"JSON Map coder not set");
+    if ([coder respondsToSelector:@selector(encodeData:)]) {
+        return [coder encodeData:object];
+    }
+    NSString *json = [coder encode:object];
+    return [MKUTF8 encode:json];
+}
+
++ (nullable NSDictionary *)decodeData:(NSData *)utf8 {
+    id<MKMapCoder> coder = [self getCoder];
+    NSAssert(coder, @"JSON Map coder not set");
+    if ([coder respondsToSelector:@selector(decodeData:)]) {
+        return [coder decodeData:utf8];
+    }
+    NSString *json = [MKUTF8 decode:utf8];
+    if (!json) {
+        return nil;
+    }
+    return [coder decode:json];
+}
+
++ (BOOL)encode:(NSDictionary *)object appendTo:(NSMutableData *)buffer {
+    id<MKMapCoder> coder = [self getCoder];
+    NSAssert(coder, @"JSON Map coder not set");
+    if ([coder respondsToSelector:@selector(encode:appendTo:)]) {
+        return [coder encode:object appendTo:buffer];
+    }
+    NSData *json = [self encodeData:object];
+    if ([json length] == 0) {
+        return NO;
+    }
+    [buffer appendData:json];
+    return YES;
+}
+
++ (nullable NSData *)encodeCanonicalData:(NSDictionary *)object {
+    NSMutableData *buffer = [[NSMutableData alloc] init];
+    if (!MKCanonicalJSONAppend(object, buffer)) {
+        return nil;
+    }
+    return buffer;
+}
+
++ (BOOL)encodeCanonical:(NSDictionary *)object appendTo:(NSMutableData *)buffer {
+    return MKCanonicalJSONAppend(object, buffer);
+}
+
 @end
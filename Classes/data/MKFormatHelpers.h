@@ -35,7 +35,7 @@
 //  Copyright © 2023 DIM Group. All rights reserved.
 //
 
-#import <Foundation/Foundation.h>
+#import <MingKeMing/MKLRUCache.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -80,9 +80,23 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (instancetype)sharedInstance;
 
-@property (strong, nonatomic, nullable) id<MKTransportableDataHelper> tedHelper;
-
-@property (strong, nonatomic, nullable) id<MKPortableNetworkFileHelper> pnfHelper;
+// atomic: safe to replace while other threads are parsing;
+// replacing it clears the TED cache
+// (its factories are its own, see 'MKFactoryRegistry' for a map that
+//  can be changed while parsing)
+@property (strong, nullable) id<MKTransportableDataHelper> tedHelper;
+
+/**
+ *  Optional cache for parsing encoded TED strings
+ *  (avatar URLs, fingerprints, small "base64,..." payloads);
+ *  parsing returns a copy of the cached TED, so it can be modified.
+ *  Cleared when 'tedHelper' is replaced or a factory is set with
+ *  MKTransportableDataSetFactory(); clear it yourself after changing
+ *  factories on the helper directly.
+ */
+@property (strong, nullable) MKLRUCache<NSString *, id<MKTransportableData>> *tedCache;
+
+@property (strong, nullable) id<MKPortableNetworkFileHelper> pnfHelper;
 
 @end
 
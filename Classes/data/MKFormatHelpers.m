@@ -35,14 +35,25 @@
 //  Copyright © 2023 DIM Group. All rights reserved.
 //
 
+#import <os/lock.h>
+
 //#import "MKCryptographyKey.h"
 //#import "MKTransportableData.h"
 //#import "MKPortableNetworkFile.h"
 
 #import "MKFormatHelpers.h"
 
+@interface MKFormatExtensions () {
+    
+    os_unfair_lock _lock;  // guards 'tedHelper'
+}
+
+@end
+
 @implementation MKFormatExtensions
 
+@synthesize tedHelper = _tedHelper;
+
 static MKFormatExtensions *s_format_ext = nil;
 
 + (instancetype)sharedInstance {
@@ -53,4 +64,26 @@ static MKFormatExtensions *s_format_ext = nil;
     return s_format_ext;
 }
 
+- (instancetype)init {
+    if (self = [super init]) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+    }
+    return self;
+}
+
+- (id<MKTransportableDataHelper>)tedHelper {
+    os_unfair_lock_lock(&_lock);
+    id<MKTransportableDataHelper> helper = _tedHelper;
+    os_unfair_lock_unlock(&_lock);
+    return helper;
+}
+
+- (void)setTedHelper:(id<MKTransportableDataHelper>)helper {
+    os_unfair_lock_lock(&_lock);
+    _tedHelper = helper;
+    os_unfair_lock_unlock(&_lock);
+    // parsed by the old helper
+    [self.tedCache removeAllObjects];
+}
+
 @end
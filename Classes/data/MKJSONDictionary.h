@@ -0,0 +1,71 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKJSONDictionary.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <MingKeMing/MKDictionary.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ *  Lazy JsON Dictionary
+ *  ~~~~~~~~~~~~~~~~~~~~
+ *  Keep the raw JsON bytes with a light index of the top-level fields,
+ *  values will be decoded only when they are read;
+ *  falls back to a full dictionary on first mutation.
+ *
+ *  NOTICE: 'dictionary' returns the real inner dictionary,
+ *          so it is taken as a mutation and drops the raw bytes;
+ *          use 'objectForKey:' / 'JSONData' to stay lazy.
+ */
+@interface MKJSONDictionary : MKDictionary
+
+/**
+ *  Original JsON bytes, nil after modified or 'dictionary' accessed
+ *  (forward it directly to avoid encoding again)
+ */
+@property (readonly, strong, nonatomic, nullable) NSData *JSONData;
+
+/**
+ *  Index top-level fields of a JsON object
+ *
+ * @param utf8 - JsON object bytes
+ * @return nil on syntax error
+ */
+- (nullable instancetype)initWithJSONData:(NSData *)utf8;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,406 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKJSONDictionary.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <os/lock.h>
+
+#import "MKDataParser.h"
+#import "MKJSONReader.h"
+
+#import "MKJSONDictionary.h"
+
+typedef struct {
+    NSUInteger keyOffset;    // without quotes
+    NSUInteger keyLength;
+    NSUInteger valueOffset;
+    NSUInteger valueLength;
+    BOOL keyEscaped;
+} MKJSONField;
+
+static inline NSUInteger skip_space(const UInt8 *bytes, NSUInteger length, NSUInteger pos) {
+    while (pos < length) {
+        UInt8 ch = bytes[pos];
+        if (ch != ' ' && ch != '\n' && ch != '\r' && ch != '\t') {
+            break;
+        }
+        ++pos;
+    }
+    return pos;
+}
+
+// build fields index for top-level JsON object
+static NSMutableData *build_index(const UInt8 *bytes, NSUInteger length) {
+    NSUInteger pos = skip_space(bytes, length, 0);
+    if (pos >= length || bytes[pos] != '{') {
+        return nil;
+    }
+    NSMutableData *tape = [[NSMutableData alloc] initWithCapacity:(16 * sizeof(MKJSONField))];
+    pos = skip_space(bytes, length, pos + 1);
+    if (pos < length && bytes[pos] == '}') {
+        // empty object
+        return tape;
+    }
+    MKJSONField field;
+    NSUInteger end;
+    for (;;) {
+        // key
+        if (pos >= length || bytes[pos] != '"') {
+            return nil;
+        }
+        end = MKJSONScanValue(bytes, length, pos);
+        if (end == NSNotFound) {
+            return nil;
+        }
+        field.keyOffset = pos + 1;
+        field.keyLength = end - pos - 2;
+        field.keyEscaped = memchr(bytes + field.keyOffset, '\\', field.keyLength) != NULL;
+        // colon
+        pos = skip_space(bytes, length, end);
+        if (pos >= length || bytes[pos] != ':') {
+            return nil;
+        }
+        // value
+        pos = skip_space(bytes, length, pos + 1);
+        end = MKJSONScanValue(bytes, length, pos);
+        if (end == NSNotFound) {
+            return nil;
+        }
+        field.valueOffset = pos;
+        field.valueLength = end - pos;
+        [tape appendBytes:&field length:sizeof(MKJSONField)];
+        // next
+        pos = skip_space(bytes, length, end);
+        if (pos >= length) {
+            return nil;
+        } else if (bytes[pos] == '}') {
+            break;
+        } else if (bytes[pos] != ',') {
+            return nil;
+        }
+        pos = skip_space(bytes, length, pos + 1);
+    }
+    return tape;
+}
+
+@interface MKJSONDictionary () {
+    
+    NSData *_raw;              // original bytes, nil after modified
+    NSMutableData *_tape;      // fields index, nil after all loaded
+    
+    // decoded values, shared with super as the inner dictionary
+    NSMutableDictionary<NSString *, id> *_cache;
+    
+    NSUInteger _count;         // distinct keys, NSNotFound for unknown
+    
+    // guards lazy decoding (_tape, _cache) for concurrent readers
+    os_unfair_lock _lock;
+}
+
+@end
+
+@implementation MKJSONDictionary
+
+- (instancetype)initWithJSONData:(NSData *)utf8 {
+    NSMutableData *tape = build_index(utf8.bytes, utf8.length);
+    if (!tape) {
+        return nil;
+    }
+    NSUInteger capacity = tape.length / sizeof(MKJSONField);
+    NSMutableDictionary *cache = [[NSMutableDictionary alloc] initWithCapacity:capacity];
+    if (self = [super initWithDictionary:cache]) {
+        _raw = utf8;
+        _tape = tape;
+        _cache = cache;
+        _count = NSNotFound;
+        _lock = OS_UNFAIR_LOCK_INIT;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(nullable NSZone *)zone {
+    if (_raw) {
+        return [[[self class] allocWithZone:zone] initWithJSONData:_raw];
+    }
+    return [super copyWithZone:zone];
+}
+
+- (NSString *)description {
+    [self _loadAll];
+    return [super description];
+}
+
+- (NSString *)debugDescription {
+    [self _loadAll];
+    return [super debugDescription];
+}
+
+- (NSData *)JSONData {
+    return _raw;
+}
+
+#pragma mark Index
+
+- (NSUInteger)_fieldCount {
+    return _tape.length / sizeof(MKJSONField);
+}
+
+- (const MKJSONField *)_fields {
+    return (const MKJSONField *)_tape.bytes;
+}
+
+- (NSData *)_slice:(NSUInteger)offset length:(NSUInteger)length {
+    // no copy, the raw bytes are retained while decoding
+    const UInt8 *bytes = _raw.bytes;
+    return [[NSData alloc] initWithBytesNoCopy:(void *)(bytes + offset)
+                                        length:length
+                                  freeWhenDone:NO];
+}
+
+- (NSString *)_keyAtIndex:(NSUInteger)index {
+    const MKJSONField *field = [self _fields] + index;
+    if (field->keyEscaped) {
+        // decode with quotes
+        NSData *slice = [self _slice:(field->keyOffset - 1) length:(field->keyLength + 2)];
+        return MKJSONDecodeValue(slice);
+    }
+    NSData *slice = [self _slice:field->keyOffset length:field->keyLength];
+    return [MKUTF8 decode:slice];
+}
+
+- (id)_valueAtIndex:(NSUInteger)index {
+    const MKJSONField *field = [self _fields] + index;
+    NSData *slice = [self _slice:field->valueOffset length:field->valueLength];
+    return MKJSONDecodeValue(slice);
+}
+
+- (NSInteger)_indexOfKey:(NSString *)aKey {
+    if (![aKey isKindOfClass:[NSString class]]) {
+        return NSNotFound;
+    }
+    const char *str = CFStringGetCStringPtr((__bridge CFStringRef)aKey, kCFStringEncodingUTF8);
+    if (!str) {
+        // NULL for unpaired surrogates, only escaped keys can match
+        str = [aKey UTF8String];
+    }
+    NSUInteger len = str ? strlen(str) : 0;
+    const UInt8 *bytes = _raw.bytes;
+    const MKJSONField *fields = [self _fields];
+    const MKJSONField *item;
+    // the last one wins
+    for (NSInteger index = [self _fieldCount] - 1; index >= 0; --index) {
+        item = fields + index;
+        if (item->keyEscaped) {
+            if ([[self _keyAtIndex:index] isEqualToString:aKey]) {
+                return index;
+            }
+        } else if (str && item->keyLength == len &&
+                   memcmp(bytes + item->keyOffset, str, len) == 0) {
+            return index;
+        }
+    }
+    return NSNotFound;
+}
+
+- (id)_lookup:(NSString *)aKey {
+    id value = [_cache objectForKey:aKey];
+    if (!value) {
+        NSInteger index = [self _indexOfKey:aKey];
+        if (index == NSNotFound) {
+            return nil;
+        }
+        value = [self _valueAtIndex:index];
+        if (value) {
+            [_cache setObject:value forKey:aKey];
+        }
+    }
+    return value;
+}
+
+- (NSUInteger)_countKeys {
+    if (_count == NSNotFound) {
+        // duplicated keys count once
+        NSUInteger fields = [self _fieldCount];
+        NSMutableSet *keys = [[NSMutableSet alloc] initWithCapacity:fields];
+        NSString *key;
+        for (NSUInteger index = 0; index < fields; ++index) {
+            key = [self _keyAtIndex:index];
+            if (key) {
+                [keys addObject:key];
+            }
+        }
+        _count = keys.count;
+    }
+    return _count;
+}
+
+// decode all values, keep raw bytes
+- (void)_loadFields {
+    if (!_tape) {
+        return;
+    }
+    NSString *key;
+    id value;
+    // the last one wins
+    for (NSInteger index = [self _fieldCount] - 1; index >= 0; --index) {
+        key = [self _keyAtIndex:index];
+        if (!key || [_cache objectForKey:key]) {
+            continue;
+        }
+        value = [self _valueAtIndex:index];
+        if (value) {
+            [_cache setObject:value forKey:key];
+        }
+    }
+    _tape = nil;
+}
+
+- (void)_loadAll {
+    os_unfair_lock_lock(&_lock);
+    [self _loadFields];
+    os_unfair_lock_unlock(&_lock);
+}
+
+// decode all values, drop raw bytes
+- (void)_willChange {
+    os_unfair_lock_lock(&_lock);
+    [self _loadFields];
+    _raw = nil;
+    os_unfair_lock_unlock(&_lock);
+}
+
+#pragma mark MKDictionary
+
+// Override
+- (BOOL)isEqual:(id)object {
+    [self _loadAll];
+    return [super isEqual:object];
+}
+
+// Override
+- (NSUInteger)hash {
+    [self _loadAll];
+    return [super hash];
+}
+
+// Override
+- (NSEnumerator<NSString *> *)keyEnumerator {
+    [self _loadAll];
+    return [super keyEnumerator];
+}
+
+// Override
+- (NSEnumerator<id> *)objectEnumerator {
+    [self _loadAll];
+    return [super objectEnumerator];
+}
+
+// Override
+- (void)enumerateKeysAndObjectsUsingBlock:(void (NS_NOESCAPE ^)(NSString *key, id obj, BOOL *stop))block {
+    [self _loadAll];
+    [super enumerateKeysAndObjectsUsingBlock:block];
+}
+
+// Override
+- (NSArray<NSString *> *)allKeys {
+    [self _loadAll];
+    return [super allKeys];
+}
+
+// Override
+- (NSUInteger)count {
+    NSUInteger count = NSNotFound;
+    os_unfair_lock_lock(&_lock);
+    if (_tape) {
+        count = [self _countKeys];
+    }
+    os_unfair_lock_unlock(&_lock);
+    return count != NSNotFound ? count : [super count];
+}
+
+// Override
+- (BOOL)isEmpty {
+    return [self count] == 0;
+}
+
+// Override
+- (NSMutableDictionary *)dictionary {
+    // the inner dictionary can be changed by the caller
+    [self _willChange];
+    return [super dictionary];
+}
+
+// Override
+- (NSMutableDictionary *)copyDictionary:(BOOL)deepCopy {
+    [self _loadAll];
+    return [super copyDictionary:deepCopy];
+}
+
+// Override
+- (id)objectForKey:(NSString *)aKey {
+    id value;
+    BOOL lazy;
+    os_unfair_lock_lock(&_lock);
+    lazy = _tape != nil;
+    value = lazy ? [self _lookup:aKey] : nil;
+    os_unfair_lock_unlock(&_lock);
+    if (!lazy) {
+        return [super objectForKey:aKey];
+    }
+    if (value == [NSNull null]) {
+        return nil;
+    }
+    return value;
+}
+
+// Override
+- (void)removeObjectForKey:(NSString *)aKey {
+    [self _willChange];
+    [super removeObjectForKey:aKey];
+}
+
+// Override
+- (void)setObject:(id)anObject forKey:(NSString *)aKey {
+    [self _willChange];
+    [super setObject:anObject forKey:aKey];
+}
+
+// Override
+- (void)setDate:(NSDate *)date forKey:(NSString *)aKey {
+    [self _willChange];
+    [super setDate:date forKey:aKey];
+}
+
+@end
@@ -0,0 +1,124 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKJSONReader.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ *  JsON Array Reader
+ *  ~~~~~~~~~~~~~~~~~
+ *  Pull parser for a top-level JsON array
+ *
+ *  1. scan UTF-8 bytes (whole data, or chunks from an input stream);
+ *  2. cut out the next element and decode it with MKJSON;
+ *  3. so only one element lives in memory at a time.
+ */
+@interface MKJSONArrayReader : NSEnumerator
+
+/**
+ *  Elements scanned so far
+ */
+@property (readonly, nonatomic) NSUInteger count;
+
+/**
+ *  Syntax error found in the array, or failed to read the stream
+ */
+@property (readonly, nonatomic, getter=isFailed) BOOL failed;
+
+- (instancetype)initWithData:(NSData *)utf8;
+
+- (instancetype)initWithStream:(NSInputStream *)stream;
+
+- (instancetype)initWithStream:(NSInputStream *)stream
+                    bufferSize:(NSUInteger)size;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Get next element as raw JsON bytes
+ *
+ * @return UTF-8 data of element; nil on end (or error)
+ */
+- (nullable NSData *)nextElementData;
+
+/**
+ *  Get next element decoded (Map, List, String, Number, ...),
+ *  invalid elements will be skipped
+ *
+ * @return element object; nil on end (or error)
+ */
+- (nullable id)nextObject;
+
+@end
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark Scanner
+
+/*
+ *  Low-level scanner used by the reader and MKJSONDictionary,
+ *  supported as public API for callers that slice JsON bytes themselves;
+ *  the value is not validated, only its bounds are found.
+ */
+
+/**
+ *  Scan a JsON value (Map, List, String, Number, ...) without decoding it
+ *
+ * @param bytes  - UTF-8 buffer
+ * @param length - buffer length
+ * @param offset - start of the value (first non-space char)
+ * @return end offset of the value (exclusive); NSNotFound on error
+ */
+NSUInteger MKJSONScanValue(const UInt8 *bytes, NSUInteger length, NSUInteger offset);
+
+/**
+ *  Decode one JsON value; scalars are handled directly,
+ *  Map/List go to MKJSON
+ *
+ * @param utf8 - JsON bytes of the value
+ * @return value object (NSNull for 'null'); nil on error
+ */
+_Nullable id MKJSONDecodeValue(NSData *utf8);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,408 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKJSONReader.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import "MKDataParser.h"
+
+#import "MKJSONReader.h"
+
+#define MKJSONReaderDefaultBufferSize  (64 * 1024)
+
+typedef NS_ENUM(UInt8, MKJSONReaderState) {
+    MKJSONReaderStateBegin,    // waiting for '['
+    MKJSONReaderStateElement,  // waiting for next element
+    MKJSONReaderStateComma,    // waiting for ',' or ']'
+    MKJSONReaderStateEnd,      // ']' reached
+    MKJSONReaderStateError,
+};
+
+static inline BOOL is_space(UInt8 ch) {
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+}
+
+static inline BOOL match_word(const UInt8 *bytes, NSUInteger len, const char *word) {
+    NSUInteger size = strlen(word);
+    return len == size && memcmp(bytes, word, size) == 0;
+}
+
+// decimal integer without fraction/exponent, e.g. '-123'
+static BOOL parse_integer(const UInt8 *bytes, NSUInteger len, long long *result) {
+    NSUInteger pos = 0;
+    BOOL negative = NO;
+    if (len > 0 && bytes[0] == '-') {
+        negative = YES;
+        pos = 1;
+    }
+    // at most 18 digits, no overflow
+    if (pos == len || len - pos > 18) {
+        return NO;
+    }
+    // no leading zeros, e.g. '01'
+    if (bytes[pos] == '0' && len - pos > 1) {
+        return NO;
+    }
+    long long value = 0;
+    for (; pos < len; ++pos) {
+        if (bytes[pos] < '0' || bytes[pos] > '9') {
+            return NO;
+        }
+        value = value * 10 + (bytes[pos] - '0');
+    }
+    *result = negative ? -value : value;
+    return YES;
+}
+
+NSUInteger MKJSONScanValue(const UInt8 *bytes, NSUInteger length, NSUInteger offset) {
+    NSUInteger depth = 0;
+    BOOL inString = NO, escaped = NO;
+    NSUInteger pos = offset;
+    UInt8 ch;
+    for (; pos < length; ++pos) {
+        ch = bytes[pos];
+        if (inString) {
+            if (escaped) {
+                escaped = NO;
+            } else if (ch == '\\') {
+                escaped = YES;
+            } else if (ch == '"') {
+                inString = NO;
+                if (depth == 0) {
+                    return pos + 1;
+                }
+            }
+        } else if (ch == '"') {
+            inString = YES;
+        } else if (ch == '{' || ch == '[') {
+            ++depth;
+        } else if (ch == '}' || ch == ']') {
+            if (depth == 0) {
+                // end of container after a scalar
+                break;
+            } else if (--depth == 0) {
+                return pos + 1;
+            }
+        } else if (depth == 0 && (ch == ',' || ch == ':' || is_space(ch))) {
+            // end of scalar
+            break;
+        }
+    }
+    if (inString || depth > 0 || pos == offset) {
+        return NSNotFound;
+    }
+    return pos;
+}
+
+id MKJSONDecodeValue(NSData *utf8) {
+    const UInt8 *bytes = utf8.bytes;
+    NSUInteger len = utf8.length;
+    if (len == 0) {
+        return nil;
+    }
+    UInt8 first = bytes[0];
+    if (first == '{' || first == '[') {
+        return [MKJSON decodeData:utf8];
+    }
+    if (first == '"') {
+        if (len > 1 && bytes[len - 1] == '"' && memchr(bytes, '\\', len) == NULL) {
+            // plain string, no escape
+            NSData *inner = [utf8 subdataWithRange:NSMakeRange(1, len - 2)];
+            return [MKUTF8 decode:inner];
+        }
+    } else if (match_word(bytes, len, "true")) {
+        return @YES;
+    } else if (match_word(bytes, len, "false")) {
+        return @NO;
+    } else if (match_word(bytes, len, "null")) {
+        return [NSNull null];
+    } else {
+        long long integer;
+        if (parse_integer(bytes, len, &integer)) {
+            return @(integer);
+        }
+    }
+    // other scalar, wrap it as a list for the JsON coder
+    NSMutableData *wrapper = [[NSMutableData alloc] initWithCapacity:(len + 2)];
+    [wrapper appendBytes:"[" length:1];
+    [wrapper appendData:utf8];
+    [wrapper appendBytes:"]" length:1];
+    NSArray *array = [MKJSON decodeData:wrapper];
+    if ([array isKindOfClass:[NSArray class]]) {
+        return [array firstObject];
+    }
+    return nil;
+}
+
+@interface MKJSONArrayReader () {
+    
+    NSInputStream *_stream;    // nil for whole data
+    NSData *_source;           // whole data
+    NSMutableData *_buffer;    // reusable chunk buffer for stream
+    NSUInteger _bufferSize;
+    
+    const UInt8 *_bytes;
+    NSUInteger _length;
+    NSUInteger _offset;
+    
+    NSMutableData *_element;   // element spanning chunks
+    
+    MKJSONReaderState _state;
+}
+
+@property (nonatomic) NSUInteger count;
+
+- (instancetype)initWithStream:(nullable NSInputStream *)stream
+                        source:(nullable NSData *)utf8
+                    bufferSize:(NSUInteger)size
+NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation MKJSONArrayReader
+
+- (instancetype)initWithData:(NSData *)utf8 {
+    return [self initWithStream:nil source:utf8 bufferSize:0];
+}
+
+- (instancetype)initWithStream:(NSInputStream *)stream {
+    return [self initWithStream:stream bufferSize:MKJSONReaderDefaultBufferSize];
+}
+
+- (instancetype)initWithStream:(NSInputStream *)stream
+                    bufferSize:(NSUInteger)size {
+    NSAssert(size > 0, @"buffer size error: %lu", size);
+    return [self initWithStream:stream source:nil bufferSize:size];
+}
+
+/* designated initializer */
+- (instancetype)initWithStream:(nullable NSInputStream *)stream
+                        source:(nullable NSData *)utf8
+                    bufferSize:(NSUInteger)size {
+    if (self = [super init]) {
+        _stream = stream;
+        _state = MKJSONReaderStateBegin;
+        _count = 0;
+        _offset = 0;
+        if (stream) {
+            _source = nil;
+            _buffer = [[NSMutableData alloc] initWithLength:size];
+            _bufferSize = size;
+            _bytes = _buffer.mutableBytes;
+            _length = 0;
+            _element = [[NSMutableData alloc] init];
+        } else {
+            _source = utf8;
+            _buffer = nil;
+            _bufferSize = 0;
+            _bytes = utf8.bytes;
+            _length = utf8.length;
+            _element = nil;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self _closeStream];
+}
+
+- (BOOL)isFailed {
+    return _state == MKJSONReaderStateError;
+}
+
+- (void)_closeStream {
+    if ([_stream streamStatus] != NSStreamStatusClosed) {
+        [_stream close];
+    }
+}
+
+- (void)_finish:(MKJSONReaderState)state {
+    _state = state;
+    [self _closeStream];
+}
+
+// read next chunk from stream
+- (BOOL)_fill {
+    if (!_stream) {
+        return NO;
+    }
+    if ([_stream streamStatus] == NSStreamStatusNotOpen) {
+        [_stream open];
+    }
+    UInt8 *buffer = _buffer.mutableBytes;
+    NSInteger cnt = [_stream read:buffer maxLength:_bufferSize];
+    if (cnt < 0) {
+        // read error, not EOF
+        [self _finish:MKJSONReaderStateError];
+        return NO;
+    } else if (cnt == 0) {
+        return NO;
+    }
+    _bytes = buffer;
+    _length = cnt;
+    _offset = 0;
+    return YES;
+}
+
+// peek next non-space char, -1 on EOF
+- (int)_peek {
+    for (;;) {
+        while (_offset < _length) {
+            UInt8 ch = _bytes[_offset];
+            if (!is_space(ch)) {
+                return ch;
+            }
+            ++_offset;
+        }
+        if (![self _fill]) {
+            return -1;
+        }
+    }
+}
+
+- (nullable NSData *)nextElementData {
+    int ch;
+    if (_state == MKJSONReaderStateBegin) {
+        ch = [self _peek];
+        if (ch != '[') {
+            [self _finish:MKJSONReaderStateError];
+            return nil;
+        }
+        ++_offset;
+        if ([self _peek] == ']') {
+            ++_offset;
+            [self _finish:MKJSONReaderStateEnd];
+            return nil;
+        }
+        _state = MKJSONReaderStateElement;
+    } else if (_state == MKJSONReaderStateComma) {
+        ch = [self _peek];
+        if (ch == ']') {
+            ++_offset;
+            [self _finish:MKJSONReaderStateEnd];
+            return nil;
+        } else if (ch != ',') {
+            [self _finish:MKJSONReaderStateError];
+            return nil;
+        }
+        ++_offset;
+        _state = MKJSONReaderStateElement;
+    } else if (_state != MKJSONReaderStateElement) {
+        // end or error
+        return nil;
+    }
+    ch = [self _peek];
+    if (ch < 0 || ch == ',' || ch == ']' || ch == '}') {
+        [self _finish:MKJSONReaderStateError];
+        return nil;
+    }
+    return [self _scanElement];
+}
+
+- (nullable NSData *)_scanElement {
+    NSUInteger depth = 0;
+    BOOL inString = NO, escaped = NO;
+    BOOL spanned = NO;
+    NSUInteger start = _offset;
+    [_element setLength:0];
+    UInt8 ch;
+    for (;;) {
+        if (_offset >= _length) {
+            // element continues in next chunk
+            [_element appendBytes:(_bytes + start) length:(_offset - start)];
+            spanned = YES;
+            if (![self _fill]) {
+                // array not closed
+                [self _finish:MKJSONReaderStateError];
+                return nil;
+            }
+            start = 0;
+            continue;
+        }
+        ch = _bytes[_offset];
+        if (inString) {
+            if (escaped) {
+                escaped = NO;
+            } else if (ch == '\\') {
+                escaped = YES;
+            } else if (ch == '"') {
+                inString = NO;
+                if (depth == 0) {
+                    ++_offset;
+                    break;
+                }
+            }
+        } else if (ch == '"') {
+            inString = YES;
+        } else if (ch == '{' || ch == '[') {
+            ++depth;
+        } else if (ch == '}' || ch == ']') {
+            if (depth == 0) {
+                // end of array after a scalar
+                break;
+            } else if (--depth == 0) {
+                ++_offset;
+                break;
+            }
+        } else if (depth == 0 && (ch == ',' || is_space(ch))) {
+            // end of scalar
+            break;
+        }
+        ++_offset;
+    }
+    _state = MKJSONReaderStateComma;
+    ++_count;
+    if (spanned) {
+        [_element appendBytes:(_bytes + start) length:(_offset - start)];
+        return [_element copy];
+    }
+    return [[NSData alloc] initWithBytes:(_bytes + start) length:(_offset - start)];
+}
+
+// Override
+- (nullable id)nextObject {
+    NSData *element;
+    id object;
+    while ((element = [self nextElementData])) {
+        object = MKJSONDecodeValue(element);
+        if (object) {
+            return object;
+        }
+        // invalid element, skip it
+    }
+    return nil;
+}
+
+@end
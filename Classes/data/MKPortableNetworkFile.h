@@ -61,7 +61,10 @@ NS_ASSUME_NONNULL_BEGIN
  *                  algorithm : "AES",   // "DES", ...
  *                  data      : "{BASE64_ENCODE}",
  *                  ...
- *              }
+ *              },
+ *              // stream cipher params of the encrypted content (optional)
+ *              IV       : "{BASE64_ENCODE}",
+ *              tag      : "{BASE64_ENCODE}"
  *      }
  */
 @protocol MKPortableNetworkFile <MKDictionary>
@@ -160,6 +163,34 @@ id<MKPortableNetworkFile> MKPortableNetworkFileCreate(_Nullable id<MKTransportab
 
 _Nullable id<MKPortableNetworkFile> MKPortableNetworkFileParse(_Nullable id pnf);
 
+/**
+ *  Create PNF from local file
+ *  (file content is memory-mapped and retained as is, it will be encoded
+ *   lazily, or chunk by chunk with 'MKPortableNetworkFileWrite()')
+ *
+ * @param path     - local file path
+ * @param filename - file name, default is the last path component
+ * @return nil on read error
+ */
+_Nullable id<MKPortableNetworkFile> MKPortableNetworkFileFromFile(NSString *path,
+                                                                  NSString * _Nullable filename);
+
+/**
+ *  Write PNF as a JsON map to stream, with file data encoded chunk by
+ *  chunk, so the whole encoded string is never built in memory:
+ *
+ *      {"filename":"...", ..., "data":"{BASE64_ENCODE}"}
+ *
+ *  Use it instead of 'pnf.object'/'pnf.string' when sending large files;
+ *  PNF classes should keep the TED out of their inner dictionary until
+ *  it is needed, so 'dictionary' does not encode the data.
+ *
+ * @param pnf  - portable network file
+ * @param sink - opened output stream
+ * @return NO on write error
+ */
+BOOL MKPortableNetworkFileWrite(id<MKPortableNetworkFile> pnf, NSOutputStream *sink);
+
 #ifdef __cplusplus
 } /* end of extern "C" */
 #endif
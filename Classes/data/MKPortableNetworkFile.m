@@ -35,7 +35,9 @@
 //  Copyright © 2023 DIM Group. All rights reserved.
 //
 
+#import "MKDataParser.h"
 #import "MKFormatHelpers.h"
+#import "MKTransportableData.h"
 
 #import "MKPortableNetworkFile.h"
 
@@ -64,3 +66,69 @@ id<MKPortableNetworkFile> MKPortableNetworkFileCreate(id<MKTransportableData> da
                                                 url:url
                                            password:password];
 }
+
+id<MKPortableNetworkFile> MKPortableNetworkFileFromFile(NSString *path, NSString *filename) {
+    // zero-copy, pages are loaded on demand
+    NSData *data = [[NSData alloc] initWithContentsOfFile:path
+                                                  options:NSDataReadingMappedIfSafe
+                                                    error:nil];
+    if (!data) {
+        return nil;
+    }
+    if (!filename) {
+        filename = [path lastPathComponent];
+    }
+    // base TED keeps the mapping, encodes on demand
+    id<MKTransportableData> ted = [[MKTransportableData alloc] initWithData:data
+                                                                 algorithm:nil];
+    return MKPortableNetworkFileCreate(ted, filename, nil, nil);
+}
+
+// write all bytes
+static BOOL write_data(NSOutputStream *sink, NSData *data) {
+    const UInt8 *bytes = data.bytes;
+    NSUInteger length = data.length;
+    NSInteger cnt;
+    while (length > 0) {
+        cnt = [sink write:bytes maxLength:length];
+        if (cnt <= 0) {
+            return NO;
+        }
+        bytes += cnt;
+        length -= cnt;
+    }
+    return YES;
+}
+
+static inline BOOL write_str(NSOutputStream *sink, const char *str) {
+    return write_data(sink, [[NSData alloc] initWithBytesNoCopy:(void *)str
+                                                         length:strlen(str)
+                                                   freeWhenDone:NO]);
+}
+
+BOOL MKPortableNetworkFileWrite(id<MKPortableNetworkFile> pnf, NSOutputStream *sink) {
+    NSMutableDictionary *info = [pnf copyDictionary:NO];
+    NSData *data = [info objectForKey:@"data"] ? nil : pnf.data;
+    if (!data) {
+        // no data, or encoded already
+        return write_data(sink, MKJsonMapEncodeData(info));
+    }
+    // other fields first: '{...' without the closing '}'
+    NSData *head = MKJsonMapEncodeData(info);
+    if (head.length < 2) {
+        return NO;
+    }
+    if (!write_data(sink, [head subdataWithRange:NSMakeRange(0, head.length - 1)])) {
+        return NO;
+    }
+    if (!write_str(sink, info.count > 0 ? ",\"data\":\"" : "\"data\":\"")) {
+        return NO;
+    }
+    // base64 needs no escaping
+    id<MKTransportableData> ted = [[MKTransportableData alloc] initWithData:data
+                                                                 algorithm:nil];
+    if (!MKTransportableDataWrite(ted, sink)) {
+        return NO;
+    }
+    return write_str(sink, "\"}");
+}
@@ -0,0 +1,117 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKPortableNetworkFileCache.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ *  PNF Cache
+ *  ~~~~~~~~~
+ *  Content-addressed local store for file payloads:
+ *
+ *      {directory}/blobs/{sha256(data)}       - payload, stored once
+ *      {directory}/urls/{sha256(url)}         - digest of the payload
+ *
+ *  1. writes go to a temporary file (synced to disk) then rename, so
+ *     readers (even from other processes) never see a partial blob;
+ *  2. reads are memory-mapped, hot payloads are served from page cache;
+ *  3. file modification time is the LRU clock, the least recently used
+ *     blobs are removed when total bytes exceed the limit (0 means
+ *     unlimited); eviction is serialized across processes with 'flock()';
+ *  4. URL entries of removed blobs are dropped on lookup and on trim;
+ *  5. temporary files left by a crashed writer are removed on trim, once
+ *     they are older than an hour.
+ */
+@interface MKPortableNetworkFileCache : NSObject
+
+@property (readonly, strong, nonatomic) NSString *directory;
+
+@property (readonly, nonatomic) unsigned long long byteLimit;
+
+- (instancetype)initWithDirectory:(NSString *)dir
+                        byteLimit:(unsigned long long)limit
+NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Store payload
+ *
+ * @param data - file content
+ * @return hex string of SHA-256 digest; nil on error
+ */
+- (nullable NSString *)storeData:(NSData *)data;
+
+/**
+ *  Store payload downloaded from URL
+ *
+ * @param data - file content
+ * @param url  - remote URL
+ * @return hex string of SHA-256 digest; nil on error
+ */
+- (nullable NSString *)storeData:(NSData *)data forURL:(NSURL *)url;
+
+/**
+ *  Get payload with digest
+ *
+ * @param digest - hex string of SHA-256 digest
+ * @return memory-mapped data; nil when not cached
+ */
+- (nullable NSData *)dataForDigest:(NSString *)digest;
+
+/**
+ *  Get payload with URL
+ *
+ * @param url - remote URL
+ * @return memory-mapped data; nil when not cached
+ */
+- (nullable NSData *)dataForURL:(NSURL *)url;
+
+- (void)removeDataForDigest:(NSString *)digest;
+
+/**
+ *  Remove least recently used blobs until total bytes under limit,
+ *  URL entries pointing to removed blobs, and stale temporary files
+ */
+- (void)trim;
+
+- (void)removeAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
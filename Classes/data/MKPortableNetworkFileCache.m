@@ -0,0 +1,393 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKPortableNetworkFileCache.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <os/lock.h>
+#import <sys/file.h>
+#import <sys/stat.h>
+#import <sys/time.h>
+#import <dirent.h>
+#import <fcntl.h>
+#import <unistd.h>
+
+#import "MKDataCoder.h"
+#import "MKDataParser.h"
+#import "MKDigester.h"
+
+#import "MKPortableNetworkFileCache.h"
+
+typedef struct {
+    char name[72];
+    off_t size;
+    struct timespec mtime;
+} MKBlobInfo;
+
+// temporary files older than this were left by a crashed writer
+#define MKPortableNetworkFileCacheTempExpires  3600  /* seconds */
+
+static inline BOOL is_temp(const char *name) {
+    size_t len = strlen(name);
+    return len > 4 && strcmp(name + len - 4, ".tmp") == 0;
+}
+
+static int compare_blob(const void *a, const void *b) {
+    const struct timespec *x = &((const MKBlobInfo *)a)->mtime;
+    const struct timespec *y = &((const MKBlobInfo *)b)->mtime;
+    if (x->tv_sec != y->tv_sec) {
+        return x->tv_sec < y->tv_sec ? -1 : 1;
+    }
+    if (x->tv_nsec != y->tv_nsec) {
+        return x->tv_nsec < y->tv_nsec ? -1 : 1;
+    }
+    return 0;
+}
+
+static inline BOOL is_digest(NSString *hex) {
+    // 64 hex chars, no path separators
+    if (hex.length != 64) {
+        return NO;
+    }
+    static NSCharacterSet *invalid;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        invalid = [[NSCharacterSet characterSetWithCharactersInString:@"0123456789abcdef"] invertedSet];
+    });
+    return [hex rangeOfCharacterFromSet:invalid].location == NSNotFound;
+}
+
+// write to temporary file, sync, then rename
+static BOOL write_atomically(NSData *data, NSString *path) {
+    NSString *tmp = [NSString stringWithFormat:@"%@.%d.%@.tmp",
+                     path, getpid(), [NSUUID UUID].UUIDString];
+    const char *tmpPath = tmp.fileSystemRepresentation;
+    int fd = open(tmpPath, O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        return NO;
+    }
+    const UInt8 *bytes = data.bytes;
+    NSUInteger length = data.length;
+    NSUInteger offset = 0;
+    ssize_t cnt;
+    while (offset < length) {
+        cnt = write(fd, bytes + offset, length - offset);
+        if (cnt < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            close(fd);
+            unlink(tmpPath);
+            return NO;
+        }
+        offset += cnt;
+    }
+    // data on disk before the name, or a crash may leave an empty blob
+    if (fsync(fd) != 0) {
+        close(fd);
+        unlink(tmpPath);
+        return NO;
+    }
+    if (close(fd) != 0 || rename(tmpPath, path.fileSystemRepresentation) != 0) {
+        unlink(tmpPath);
+        return NO;
+    }
+    return YES;
+}
+
+@interface MKPortableNetworkFileCache () {
+
+    NSString *_blobs;
+    NSString *_urls;
+    NSString *_lockFile;
+
+    os_unfair_lock _lock;
+    unsigned long long _written;  // bytes stored since last trim
+    BOOL _trimming;
+
+    dispatch_queue_t _queue;
+}
+
+@property (strong, nonatomic) NSString *directory;
+@property (nonatomic) unsigned long long byteLimit;
+
+@end
+
+@implementation MKPortableNetworkFileCache
+
+/* designated initializer */
+- (instancetype)initWithDirectory:(NSString *)dir
+                        byteLimit:(unsigned long long)limit {
+    if (self = [super init]) {
+        self.directory = dir;
+        self.byteLimit = limit;
+        _blobs = [dir stringByAppendingPathComponent:@"blobs"];
+        _urls = [dir stringByAppendingPathComponent:@"urls"];
+        _lockFile = [dir stringByAppendingPathComponent:@".lock"];
+        NSFileManager *fm = [NSFileManager defaultManager];
+        [fm createDirectoryAtPath:_blobs withIntermediateDirectories:YES attributes:nil error:nil];
+        [fm createDirectoryAtPath:_urls withIntermediateDirectories:YES attributes:nil error:nil];
+        _lock = OS_UNFAIR_LOCK_INIT;
+        // size of existing blobs unknown, check on first store
+        _written = limit;
+        _trimming = NO;
+        dispatch_queue_attr_t attr;
+        attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_BACKGROUND, 0);
+        _queue = dispatch_queue_create("chat.dim.pnf.cache", attr);
+    }
+    return self;
+}
+
+- (NSString *)_blobPath:(NSString *)digest {
+    return [_blobs stringByAppendingPathComponent:digest];
+}
+
+- (NSString *)_urlPath:(NSURL *)url {
+    NSData *utf8 = MKUTF8Encode(url.absoluteString);
+    return [_urls stringByAppendingPathComponent:MKHexEncode(MKSHA256Digest(utf8))];
+}
+
+- (nullable NSString *)storeData:(NSData *)data {
+    NSString *digest = MKHexEncode(MKSHA256Digest(data));
+    NSString *path = [self _blobPath:digest];
+    const char *cPath = path.fileSystemRepresentation;
+    if (access(cPath, F_OK) == 0) {
+        // stored already, refresh LRU clock
+        utimes(cPath, NULL);
+        return digest;
+    }
+    if (!write_atomically(data, path)) {
+        return nil;
+    }
+    [self _didWrite:data.length];
+    return digest;
+}
+
+- (nullable NSString *)storeData:(NSData *)data forURL:(NSURL *)url {
+    NSString *digest = [self storeData:data];
+    if (digest) {
+        write_atomically(MKUTF8Encode(digest), [self _urlPath:url]);
+    }
+    return digest;
+}
+
+- (nullable NSData *)dataForDigest:(NSString *)digest {
+    if (!is_digest(digest)) {
+        return nil;
+    }
+    NSString *path = [self _blobPath:digest];
+    // the mapping stays valid even if the blob is evicted meanwhile
+    NSData *data = [[NSData alloc] initWithContentsOfFile:path
+                                                  options:NSDataReadingMappedAlways
+                                                    error:nil];
+    if (data) {
+        utimes(path.fileSystemRepresentation, NULL);
+    }
+    return data;
+}
+
+- (nullable NSData *)dataForURL:(NSURL *)url {
+    NSString *path = [self _urlPath:url];
+    NSData *utf8 = [[NSData alloc] initWithContentsOfFile:path];
+    if (!utf8) {
+        return nil;
+    }
+    NSString *digest = MKUTF8Decode(utf8);
+    NSData *data = digest ? [self dataForDigest:digest] : nil;
+    if (!data) {
+        // blob evicted (or entry broken), drop the entry
+        unlink(path.fileSystemRepresentation);
+    }
+    return data;
+}
+
+- (void)removeDataForDigest:(NSString *)digest {
+    if (is_digest(digest)) {
+        unlink([self _blobPath:digest].fileSystemRepresentation);
+    }
+}
+
+- (void)_didWrite:(NSUInteger)length {
+    BOOL needsTrim = NO;
+    if (_byteLimit == 0) {
+        // unlimited
+        return;
+    }
+    os_unfair_lock_lock(&_lock);
+    _written += length;
+    // check once per 1/8 limit written
+    if (!_trimming && _written >= _byteLimit / 8) {
+        _trimming = needsTrim = YES;
+    }
+    os_unfair_lock_unlock(&_lock);
+    if (needsTrim) {
+        dispatch_async(_queue, ^{
+            [self trim];
+        });
+    }
+}
+
+- (void)trim {
+    int lockFd = open(_lockFile.fileSystemRepresentation, O_RDWR | O_CREAT, 0644);
+    if (lockFd < 0) {
+        return;
+    }
+    // one evictor at a time, across processes
+    flock(lockFd, LOCK_EX);
+
+    os_unfair_lock_lock(&_lock);
+    _written = 0;
+    os_unfair_lock_unlock(&_lock);
+
+    BOOL evicted = NO;
+    time_t expires = time(NULL) - MKPortableNetworkFileCacheTempExpires;
+    DIR *dir = opendir(_blobs.fileSystemRepresentation);
+    if (dir) {
+        int dirFd = dirfd(dir);
+        NSUInteger capacity = 256, count = 0;
+        MKBlobInfo *items = malloc(capacity * sizeof(MKBlobInfo));
+        unsigned long long total = 0;
+        struct dirent *entry;
+        struct stat st;
+        while (items && (entry = readdir(dir))) {
+            if (entry->d_name[0] == '.') {
+                continue;
+            }
+            if (fstatat(dirFd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0 || !S_ISREG(st.st_mode)) {
+                continue;
+            }
+            if (is_temp(entry->d_name)) {
+                // in-flight write, or leaked by a crash
+                if (st.st_mtimespec.tv_sec < expires) {
+                    unlinkat(dirFd, entry->d_name, 0);
+                }
+                continue;
+            } else if (strlen(entry->d_name) >= sizeof(items->name)) {
+                continue;
+            }
+            if (count == capacity) {
+                MKBlobInfo *bigger = realloc(items, capacity * 2 * sizeof(MKBlobInfo));
+                if (!bigger) {
+                    break;
+                }
+                items = bigger;
+                capacity *= 2;
+            }
+            strcpy(items[count].name, entry->d_name);
+            items[count].size = st.st_size;
+            items[count].mtime = st.st_mtimespec;
+            total += st.st_size;
+            ++count;
+        }
+        if (items && _byteLimit > 0 && total > _byteLimit) {
+            // least recently used first
+            qsort(items, count, sizeof(MKBlobInfo), compare_blob);
+            for (NSUInteger i = 0; i < count && total > _byteLimit; ++i) {
+                if (unlinkat(dirFd, items[i].name, 0) == 0) {
+                    total -= items[i].size;
+                    evicted = YES;
+                }
+            }
+        }
+        free(items);
+        closedir(dir);
+    }
+    [self _pruneURLs:evicted expires:expires];
+
+    flock(lockFd, LOCK_UN);
+    close(lockFd);
+
+    os_unfair_lock_lock(&_lock);
+    _trimming = NO;
+    os_unfair_lock_unlock(&_lock);
+}
+
+// drop URL entries whose blob is gone (after eviction), and stale temporary files
+- (void)_pruneURLs:(BOOL)evicted expires:(time_t)expires {
+    DIR *dir = opendir(_urls.fileSystemRepresentation);
+    if (!dir) {
+        return;
+    }
+    int dirFd = dirfd(dir);
+    int blobsFd = open(_blobs.fileSystemRepresentation, O_RDONLY | O_DIRECTORY);
+    if (blobsFd < 0) {
+        closedir(dir);
+        return;
+    }
+    char digest[65];
+    struct dirent *entry;
+    struct stat st;
+    int fd;
+    ssize_t cnt;
+    while ((entry = readdir(dir))) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        } else if (is_temp(entry->d_name)) {
+            if (fstatat(dirFd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 &&
+                st.st_mtimespec.tv_sec < expires) {
+                unlinkat(dirFd, entry->d_name, 0);
+            }
+            continue;
+        } else if (!evicted) {
+            continue;
+        }
+        fd = openat(dirFd, entry->d_name, O_RDONLY);
+        if (fd < 0) {
+            continue;
+        }
+        cnt = read(fd, digest, 64);
+        close(fd);
+        if (cnt == 64) {
+            digest[64] = '\0';
+            if (strchr(digest, '/') == NULL && faccessat(blobsFd, digest, F_OK, 0) == 0) {
+                // still cached
+                continue;
+            }
+        }
+        unlinkat(dirFd, entry->d_name, 0);
+    }
+    close(blobsFd);
+    closedir(dir);
+}
+
+- (void)removeAll {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    for (NSString *dir in @[_blobs, _urls]) {
+        for (NSString *name in [fm contentsOfDirectoryAtPath:dir error:nil]) {
+            [fm removeItemAtPath:[dir stringByAppendingPathComponent:name] error:nil];
+        }
+    }
+}
+
+@end
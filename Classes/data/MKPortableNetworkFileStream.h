@@ -0,0 +1,222 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKPortableNetworkFileStream.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol MKEncryptKey;
+@protocol MKDecryptKey;
+@protocol MKPortableNetworkFile;
+
+FOUNDATION_EXPORT NSErrorDomain const MKPortableNetworkFileErrorDomain;
+
+typedef NS_ERROR_ENUM(MKPortableNetworkFileErrorDomain, MKPortableNetworkFileError) {
+    MKPortableNetworkFileErrorRead = 1,
+    MKPortableNetworkFileErrorWrite,
+    MKPortableNetworkFileErrorDecrypt,
+    MKPortableNetworkFileErrorEncrypt,
+    MKPortableNetworkFileErrorUnsupported,  // key can't stream, file too big
+};
+
+// default 'wholeFileLimit': 4 MB
+#define MKPortableNetworkFileWholeFileLimit  (4 * 1024 * 1024)
+
+/*
+ *  PNF Decrypter
+ *  ~~~~~~~~~~~~~
+ *  Decrypt a downloaded file chunk by chunk:
+ *
+ *      source (file://) -> [read queue] -> chunks -> [decrypt queue] -> sink
+ *
+ *  1. reading the next chunk overlaps with decrypting the previous one;
+ *  2. at most 'maxPendingChunks' chunks are in flight, so memory stays
+ *     constant whatever the file size is;
+ *  3. if the password does not support 'decryptStream:', the whole file
+ *     has to be loaded and decrypted at once, so it's allowed only when the
+ *     file is not bigger than 'wholeFileLimit', otherwise it fails with
+ *     'MKPortableNetworkFileErrorUnsupported' (set the limit to 0 to reject
+ *     such keys always);
+ *  4. no password means plain data, just copy.
+ *
+ *  NOTICE: a stream cipher (e.g. AES-CTR + HMAC) checks its tag only after
+ *          the last chunk, so when writing to a stream, the plaintext
+ *          written before an error is unauthenticated and MUST be
+ *          discarded; 'decryptFile:toFile:completion:' writes to a
+ *          temporary file and moves it into place only on success.
+ */
+@interface MKPortableNetworkFileDecrypter : NSObject
+
+@property (readonly, strong, nonatomic, nullable) id<MKDecryptKey> password;
+@property (readonly, strong, nonatomic, nullable) NSDictionary<NSString *, id> *params;
+
+@property (nonatomic) NSUInteger chunkSize;         // default: 256 KB
+@property (nonatomic) NSUInteger maxPendingChunks;  // default: 4
+@property (nonatomic) NSUInteger wholeFileLimit;    // default: 4 MB
+
+- (instancetype)initWithPassword:(nullable id<MKDecryptKey>)key
+                          params:(nullable NSDictionary<NSString *, id> *)extra
+NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Decrypt file to output stream
+ *
+ * @param source - local file URL of the encrypted data
+ * @param sink   - output stream for plaintext (file, memory, ...)
+ * @param block  - callback on finished (on a private queue)
+ */
+- (void)decryptFile:(NSURL *)source
+           toStream:(NSOutputStream *)sink
+         completion:(void (^)(NSError * _Nullable error))block;
+
+/**
+ *  Decrypt file to another file, committed after verification
+ *
+ * @param source      - local file URL of the encrypted data
+ * @param destination - local file URL for plaintext (replaced on success,
+ *                      untouched on error)
+ * @param block       - callback on finished (on a private queue)
+ */
+- (void)decryptFile:(NSURL *)source
+             toFile:(NSURL *)destination
+         completion:(void (^)(NSError * _Nullable error))block;
+
+@end
+
+/*
+ *  PNF Encrypter
+ *  ~~~~~~~~~~~~~
+ *  Encrypt a file for uploading chunk by chunk:
+ *
+ *      source (file://) -> [read queue] -> chunks -> [encrypt queue] -> sink
+ *
+ *  The sink gets the ciphertext only; cipher params ("IV", "tag") are
+ *  returned to the callback after the last chunk, for the PNF to carry.
+ *
+ *  1. same pipeline as the decrypter, memory stays constant;
+ *  2. if the password does not support 'encryptStream:', the whole file
+ *     has to be loaded, same limit as the decrypter ('wholeFileLimit').
+ */
+@interface MKPortableNetworkFileEncrypter : NSObject
+
+@property (readonly, strong, nonatomic) id<MKEncryptKey> password;
+
+@property (nonatomic) NSUInteger chunkSize;         // default: 256 KB
+@property (nonatomic) NSUInteger maxPendingChunks;  // default: 4
+@property (nonatomic) NSUInteger wholeFileLimit;    // default: 4 MB
+
+- (instancetype)initWithPassword:(id<MKEncryptKey>)key
+NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Encrypt file to output stream
+ *
+ * @param source - local file URL of the plain data
+ * @param sink   - output stream for ciphertext
+ * @param block  - callback with cipher params ('IV', 'tag') on success
+ *                 (on a private queue)
+ */
+- (void)encryptFile:(NSURL *)source
+           toStream:(NSOutputStream *)sink
+         completion:(void (^)(NSDictionary<NSString *, id> * _Nullable params,
+                              NSError * _Nullable error))block;
+
+/**
+ *  Encrypt file to another file, committed after the last chunk
+ *
+ * @param source      - local file URL of the plain data
+ * @param destination - local file URL for ciphertext (replaced on success,
+ *                      untouched on error)
+ * @param block       - callback with cipher params ('IV', 'tag') on success
+ *                      (on a private queue)
+ */
+- (void)encryptFile:(NSURL *)source
+             toFile:(NSURL *)destination
+         completion:(void (^)(NSDictionary<NSString *, id> * _Nullable params,
+                              NSError * _Nullable error))block;
+
+@end
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Decrypt downloaded file with PNF password,
+ *  cipher params ("IV", "tag") are taken from the PNF:
+ *
+ *      {
+ *          URL : "http://...",
+ *          key : {...},
+ *          IV  : "{BASE64_ENCODE}",
+ *          tag : "{BASE64_ENCODE}"
+ *      }
+ *
+ * @param pnf         - portable network file
+ * @param source      - local file URL of the downloaded data
+ * @param destination - local file URL for plaintext, written on success only
+ * @param block       - callback on finished
+ */
+void MKPortableNetworkFileDecrypt(id<MKPortableNetworkFile> pnf,
+                                  NSURL *source,
+                                  NSURL *destination,
+                                  void (^block)(NSError * _Nullable error));
+
+/**
+ *  Encrypt file for uploading with PNF password,
+ *  cipher params ("IV", "tag") are stored into the PNF on success
+ *  (before calling back)
+ *
+ * @param pnf         - portable network file, with a symmetric password
+ * @param source      - local file URL of the plain data
+ * @param destination - local file URL for ciphertext, written on success only
+ * @param block       - callback on finished
+ */
+void MKPortableNetworkFileEncrypt(id<MKPortableNetworkFile> pnf,
+                                  NSURL *source,
+                                  NSURL *destination,
+                                  void (^block)(NSError * _Nullable error));
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,420 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKPortableNetworkFileStream.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <stdatomic.h>
+#import <stdio.h>
+#import <sys/stat.h>
+#import <unistd.h>
+
+#import "MKDataCoder.h"
+#import "MKCryptographyKey.h"
+#import "MKPortableNetworkFile.h"
+
+#import "MKPortableNetworkFileStream.h"
+
+NSErrorDomain const MKPortableNetworkFileErrorDomain = @"MKPortableNetworkFileErrorDomain";
+
+static inline NSError *make_error(MKPortableNetworkFileError code, NSError *reason) {
+    NSDictionary *info = reason ? @{NSUnderlyingErrorKey: reason} : nil;
+    return [NSError errorWithDomain:MKPortableNetworkFileErrorDomain
+                               code:code
+                           userInfo:info];
+}
+
+// write all bytes
+static BOOL write_data(NSOutputStream *sink, NSData *data) {
+    const UInt8 *bytes = data.bytes;
+    NSUInteger length = data.length;
+    NSUInteger offset = 0;
+    NSInteger cnt;
+    while (offset < length) {
+        cnt = [sink write:(bytes + offset) maxLength:(length - offset)];
+        if (cnt <= 0) {
+            return NO;
+        }
+        offset += cnt;
+    }
+    return YES;
+}
+
+// -1 on error
+static long long file_size(NSURL *source) {
+    struct stat st;
+    if (stat(source.fileSystemRepresentation, &st) != 0) {
+        return -1;
+    }
+    return st.st_size;
+}
+
+// load the whole file and process it at once (keys without stream support)
+static void process_file(dispatch_queue_t queue, NSURL *source, NSOutputStream *sink,
+                         NSUInteger limit, MKPortableNetworkFileError code,
+                         NSData * _Nullable (^handler)(NSData *input),
+                         void (^block)(NSError * _Nullable error)) {
+    dispatch_async(queue, ^{
+        long long size = file_size(source);
+        if (size < 0) {
+            NSError *reason = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+            block(make_error(MKPortableNetworkFileErrorRead, reason));
+            return;
+        } else if ((unsigned long long)size > limit) {
+            // too big to be loaded into memory
+            block(make_error(MKPortableNetworkFileErrorUnsupported, nil));
+            return;
+        }
+        NSError *error = nil;
+        NSData *data = [[NSData alloc] initWithContentsOfURL:source
+                                                     options:NSDataReadingMappedIfSafe
+                                                       error:&error];
+        if (!data) {
+            block(make_error(MKPortableNetworkFileErrorRead, error));
+            return;
+        }
+        NSData *output = handler(data);
+        if (!output) {
+            block(make_error(code, nil));
+            return;
+        }
+        [sink open];
+        BOOL ok = write_data(sink, output);
+        [sink close];
+        block(ok ? nil : make_error(MKPortableNetworkFileErrorWrite, sink.streamError));
+    });
+}
+
+/**
+ *  Pipeline: source -> [read queue] -> chunks -> [cipher queue] -> sink
+ *
+ * @param cipher - nil means plain data, just copy
+ * @param code   - error code when the cipher fails
+ */
+static void process_stream(dispatch_queue_t readQueue, dispatch_queue_t cipherQueue,
+                           NSURL *source, NSOutputStream *sink,
+                           id<MKCipherStream> _Nullable cipher, MKPortableNetworkFileError code,
+                           NSUInteger chunkSize, NSUInteger maxPendingChunks,
+                           void (^block)(NSError * _Nullable error)) {
+    dispatch_semaphore_t pending = dispatch_semaphore_create(maxPendingChunks);
+    // error code, set once
+    __block atomic_int failed = 0;
+    __block NSError *reason = nil;
+    
+    dispatch_async(readQueue, ^{
+        NSInputStream *input = [[NSInputStream alloc] initWithURL:source];
+        [input open];
+        dispatch_async(cipherQueue, ^{
+            [sink open];
+        });
+        NSMutableData *chunk;
+        NSInteger cnt;
+        while (atomic_load(&failed) == 0) {
+            dispatch_semaphore_wait(pending, DISPATCH_TIME_FOREVER);
+            chunk = [[NSMutableData alloc] initWithLength:chunkSize];
+            cnt = [input read:chunk.mutableBytes maxLength:chunkSize];
+            if (cnt <= 0) {
+                if (cnt < 0) {
+                    NSError *error = input.streamError;
+                    dispatch_async(cipherQueue, ^{
+                        int expected = 0;
+                        if (atomic_compare_exchange_strong(&failed, &expected, MKPortableNetworkFileErrorRead)) {
+                            reason = error;
+                        }
+                    });
+                }
+                dispatch_semaphore_signal(pending);
+                break;
+            }
+            [chunk setLength:cnt];
+            dispatch_async(cipherQueue, ^{
+                if (atomic_load(&failed) == 0) {
+                    NSData *output = cipher ? [cipher update:chunk] : chunk;
+                    if (!output) {
+                        atomic_store(&failed, code);
+                    } else if (!write_data(sink, output)) {
+                        reason = sink.streamError;
+                        atomic_store(&failed, MKPortableNetworkFileErrorWrite);
+                    }
+                }
+                dispatch_semaphore_signal(pending);
+            });
+        }
+        [input close];
+        dispatch_async(cipherQueue, ^{
+            if (atomic_load(&failed) == 0 && cipher) {
+                NSData *output = [cipher finish];
+                if (!output) {
+                    atomic_store(&failed, code);
+                } else if (!write_data(sink, output)) {
+                    reason = sink.streamError;
+                    atomic_store(&failed, MKPortableNetworkFileErrorWrite);
+                }
+            }
+            [sink close];
+            int error = atomic_load(&failed);
+            block(error == 0 ? nil : make_error(error, reason));
+        });
+    });
+}
+
+/**
+ *  Write to a temporary file in the same directory, so rename is atomic;
+ *  the destination is replaced on success only.
+ */
+static void process_to_file(NSURL *destination,
+                            void (^process)(NSOutputStream *sink, void (^done)(NSError * _Nullable error)),
+                            void (^block)(NSError * _Nullable error)) {
+    NSString *path = destination.path;
+    NSString *tmp = [NSString stringWithFormat:@"%@.%@.tmp", path, [NSUUID UUID].UUIDString];
+    NSOutputStream *sink = [[NSOutputStream alloc] initToFileAtPath:tmp append:NO];
+    process(sink, ^(NSError *error) {
+        if (!error && rename(tmp.fileSystemRepresentation, path.fileSystemRepresentation) != 0) {
+            NSError *reason = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+            error = make_error(MKPortableNetworkFileErrorWrite, reason);
+        }
+        if (error) {
+            // incomplete or unverified
+            unlink(tmp.fileSystemRepresentation);
+        }
+        block(error);
+    });
+}
+
+#pragma mark - Decrypter
+
+@interface MKPortableNetworkFileDecrypter () {
+    
+    dispatch_queue_t _readQueue;
+    dispatch_queue_t _decryptQueue;
+}
+
+@property (strong, nonatomic, nullable) id<MKDecryptKey> password;
+@property (strong, nonatomic, nullable) NSDictionary<NSString *, id> *params;
+
+@end
+
+@implementation MKPortableNetworkFileDecrypter
+
+/* designated initializer */
+- (instancetype)initWithPassword:(nullable id<MKDecryptKey>)key
+                          params:(nullable NSDictionary<NSString *, id> *)extra {
+    if (self = [super init]) {
+        self.password = key;
+        self.params = extra;
+        self.chunkSize = 256 * 1024;
+        self.maxPendingChunks = 4;
+        self.wholeFileLimit = MKPortableNetworkFileWholeFileLimit;
+        dispatch_queue_attr_t attr;
+        attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
+        _readQueue = dispatch_queue_create("chat.dim.pnf.read", attr);
+        _decryptQueue = dispatch_queue_create("chat.dim.pnf.decrypt", attr);
+    }
+    return self;
+}
+
+- (void)decryptFile:(NSURL *)source
+           toStream:(NSOutputStream *)sink
+         completion:(void (^)(NSError * _Nullable))block {
+    id<MKDecryptKey> key = self.password;
+    NSDictionary *extra = self.params;
+    if (key && ![key respondsToSelector:@selector(decryptStream:)]) {
+        // decrypt at once
+        process_file(_readQueue, source, sink, self.wholeFileLimit, MKPortableNetworkFileErrorDecrypt,
+                     ^NSData *(NSData *ciphertext) {
+            return [key decrypt:ciphertext params:extra];
+        }, block);
+        return;
+    }
+    // nil stream means plain data
+    id<MKCipherStream> cipher = [key decryptStream:extra];
+    if (key && !cipher) {
+        dispatch_async(_readQueue, ^{
+            block(make_error(MKPortableNetworkFileErrorDecrypt, nil));
+        });
+        return;
+    }
+    process_stream(_readQueue, _decryptQueue, source, sink, cipher, MKPortableNetworkFileErrorDecrypt,
+                   self.chunkSize, self.maxPendingChunks, block);
+}
+
+- (void)decryptFile:(NSURL *)source
+             toFile:(NSURL *)destination
+         completion:(void (^)(NSError * _Nullable))block {
+    process_to_file(destination, ^(NSOutputStream *sink, void (^done)(NSError *)) {
+        [self decryptFile:source toStream:sink completion:done];
+    }, block);
+}
+
+@end
+
+#pragma mark - Encrypter
+
+@interface MKPortableNetworkFileEncrypter () {
+    
+    dispatch_queue_t _readQueue;
+    dispatch_queue_t _encryptQueue;
+}
+
+@property (strong, nonatomic) id<MKEncryptKey> password;
+
+@end
+
+@implementation MKPortableNetworkFileEncrypter
+
+/* designated initializer */
+- (instancetype)initWithPassword:(id<MKEncryptKey>)key {
+    if (self = [super init]) {
+        self.password = key;
+        self.chunkSize = 256 * 1024;
+        self.maxPendingChunks = 4;
+        self.wholeFileLimit = MKPortableNetworkFileWholeFileLimit;
+        dispatch_queue_attr_t attr;
+        attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
+        _readQueue = dispatch_queue_create("chat.dim.pnf.read", attr);
+        _encryptQueue = dispatch_queue_create("chat.dim.pnf.encrypt", attr);
+    }
+    return self;
+}
+
+- (void)encryptFile:(NSURL *)source
+           toStream:(NSOutputStream *)sink
+         completion:(void (^)(NSDictionary<NSString *, id> * _Nullable,
+                              NSError * _Nullable))block {
+    id<MKEncryptKey> key = self.password;
+    // each file gets its own params ('IV' is random)
+    NSMutableDictionary *params = [[NSMutableDictionary alloc] initWithCapacity:2];
+    if (![key respondsToSelector:@selector(encryptStream:)]) {
+        // encrypt at once
+        process_file(_readQueue, source, sink, self.wholeFileLimit, MKPortableNetworkFileErrorEncrypt,
+                     ^NSData *(NSData *plaintext) {
+            return [key encrypt:plaintext extra:params];
+        }, ^(NSError *error) {
+            block(error ? nil : params, error);
+        });
+        return;
+    }
+    id<MKCipherStream> cipher = [key encryptStream:params];
+    if (!cipher) {
+        dispatch_async(_readQueue, ^{
+            block(nil, make_error(MKPortableNetworkFileErrorEncrypt, nil));
+        });
+        return;
+    }
+    process_stream(_readQueue, _encryptQueue, source, sink, cipher, MKPortableNetworkFileErrorEncrypt,
+                   self.chunkSize, self.maxPendingChunks, ^(NSError *error) {
+        if (error) {
+            block(nil, error);
+            return;
+        }
+        // the tag is ready after 'finish'
+        if (![params objectForKey:@"tag"] && [cipher respondsToSelector:@selector(tag)]) {
+            NSData *tag = cipher.tag;
+            if (tag) {
+                [params setObject:MKBase64Encode(tag) forKey:@"tag"];
+            }
+        }
+        block(params, nil);
+    });
+}
+
+- (void)encryptFile:(NSURL *)source
+             toFile:(NSURL *)destination
+         completion:(void (^)(NSDictionary<NSString *, id> * _Nullable,
+                              NSError * _Nullable))block {
+    __block NSDictionary *params = nil;
+    process_to_file(destination, ^(NSOutputStream *sink, void (^done)(NSError *)) {
+        [self encryptFile:source toStream:sink completion:^(NSDictionary *extra, NSError *error) {
+            params = extra;
+            done(error);
+        }];
+    }, ^(NSError *error) {
+        block(error ? nil : params, error);
+    });
+}
+
+@end
+
+// stream cipher params carried by the PNF
+static NSDictionary *cipher_params(id<MKPortableNetworkFile> pnf) {
+    NSMutableDictionary *params = [[NSMutableDictionary alloc] initWithCapacity:2];
+    id value;
+    for (NSString *name in @[@"IV", @"tag"]) {
+        value = [pnf objectForKey:name];
+        if (value) {
+            [params setObject:value forKey:name];
+        }
+    }
+    return params;
+}
+
+void MKPortableNetworkFileDecrypt(id<MKPortableNetworkFile> pnf,
+                                  NSURL *source,
+                                  NSURL *destination,
+                                  void (^block)(NSError * _Nullable)) {
+    MKPortableNetworkFileDecrypter *decrypter;
+    decrypter = [[MKPortableNetworkFileDecrypter alloc] initWithPassword:pnf.password
+                                                                  params:cipher_params(pnf)];
+    [decrypter decryptFile:source toFile:destination completion:block];
+}
+
+void MKPortableNetworkFileEncrypt(id<MKPortableNetworkFile> pnf,
+                                  NSURL *source,
+                                  NSURL *destination,
+                                  void (^block)(NSError * _Nullable)) {
+    id key = pnf.password;
+    if (![key conformsToProtocol:@protocol(MKEncryptKey)]) {
+        // no password to encrypt with
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+            block(make_error(MKPortableNetworkFileErrorUnsupported, nil));
+        });
+        return;
+    }
+    MKPortableNetworkFileEncrypter *encrypter;
+    encrypter = [[MKPortableNetworkFileEncrypter alloc] initWithPassword:key];
+    [encrypter encryptFile:source toFile:destination completion:^(NSDictionary *params, NSError *error) {
+        if (!error) {
+            // carried by the PNF for the receiver
+            for (NSString *name in @[@"IV", @"tag"]) {
+                id value = [params objectForKey:name];
+                if (value) {
+                    [pnf setObject:value forKey:name];
+                } else {
+                    [pnf removeObjectForKey:name];
+                }
+            }
+        }
+        block(error);
+    }];
+}
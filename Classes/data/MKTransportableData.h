@@ -36,6 +36,7 @@
 //
 
 #import <MingKeMing/MKDictionary.h>
+#import <MingKeMing/MKTypeTag.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -62,11 +63,13 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  *  Get original data
+ *  (decode lazily on first access, and cache it)
  */
 @property (readonly, strong, nonatomic, nullable) NSData *data;
 
 /**
  *  Get encoded string
+ *  (encode once, and keep it; a parsed TED returns the original string)
  *
  * @return "{BASE64_ENCODE}}", or
  *         "base64,{BASE64_ENCODE}", or
@@ -106,6 +109,66 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+#pragma mark - Base TED
+
+/*
+ *  Lazy TED
+ *  ~~~~~~~~
+ *  1. parsed from string: keep the encoded string, decode on first 'data'
+ *     access; decoded bytes are kept with the TED, big ones (64 KiB+) as
+ *     purgeable memory, which the system may reclaim while no returned
+ *     'data' is alive, then it is decoded again on next access;
+ *  2. created from data: encode on first 'string'/'object' access,
+ *     the encoded string is kept;
+ *  3. forwarding 'object' of a parsed TED never decodes anything.
+ *
+ *  Reading is thread safe; copies have their own inner dictionary and
+ *  share the memoized values until one of them changes.
+ *  'dictionary' returns the real inner dictionary, for a TED created
+ *  from data the encoded "data" is stored into it on first call;
+ *  change "algorithm"/"data" with 'setObject:forKey:', so the
+ *  memoized values are dropped.
+ *
+ *  Algorithms: "base64" (default), "base58", "hex";
+ *  others get nil 'data' (and empty 'string' when created from data).
+ */
+@interface MKTransportableData : MKDictionary <MKTransportableData>
+
+/**
+ *  Tag of encode algorithm (resolved on init and on change)
+ */
+@property (readonly, nonatomic) MKTypeTag algorithmTag;
+
+/**
+ *  Create with original data
+ *
+ * @param data - original data
+ * @param name - encode algorithm, nil means plain "{BASE64_ENCODE}"
+ */
+- (instancetype)initWithData:(NSData *)data algorithm:(nullable NSString *)name;
+
+/**
+ *  Parse encoded string
+ *
+ * @param string - "{BASE64_ENCODE}", or
+ *                 "base64,{BASE64_ENCODE}", or
+ *                 "data:image/png;base64,{BASE64_ENCODE}"
+ */
+- (instancetype)initWithString:(NSString *)string;
+
+/**
+ *  Write encoded string to stream
+ *  (when created from data, "base64" and "hex" are encoded chunk by chunk
+ *   with the current MKBase64/MKHex coders, so a memory-mapped file is
+ *   never copied into the heap at once)
+ *
+ * @param sink - opened output stream
+ * @return NO on write error
+ */
+- (BOOL)writeToStream:(NSOutputStream *)sink;
+
+@end
+
 #pragma mark - Conveniences
 
 #define MKTransportableDataEncode(data)                                        \
@@ -127,6 +190,15 @@ id<MKTransportableData> MKTransportableDataCreate(NSData *data, NSString * _Null
 
 _Nullable id<MKTransportableData> MKTransportableDataParse(_Nullable id ted);
 
+/**
+ *  Write TED string to output stream
+ *
+ * @param ted  - TED object
+ * @param sink - opened output stream
+ * @return NO on write error
+ */
+BOOL MKTransportableDataWrite(id<MKTransportableData> ted, NSOutputStream *sink);
+
 #ifdef __cplusplus
 } /* end of extern "C" */
 #endif
@@ -35,6 +35,11 @@
 //  Copyright © 2023 DIM Group. All rights reserved.
 //
 
+#import <os/lock.h>
+
+#import "MKConverter.h"
+#import "MKDataCoder.h"
+#import "MKDataParser.h"
 #import "MKFormatHelpers.h"
 
 #import "MKTransportableData.h"
@@ -47,6 +52,8 @@ id<MKTransportableDataFactory> MKTransportableDataGetFactory(NSString *algorithm
 void MKTransportableDataSetFactory(NSString *algorithm, id<MKTransportableDataFactory> factory) {
     MKFormatExtensions *ext = [MKFormatExtensions sharedInstance];
     [ext.tedHelper setTransportableDataFactory:factory algorithm:algorithm];
+    // parsed by the old factory
+    [ext.tedCache removeAllObjects];
 }
 
 id<MKTransportableData> MKTransportableDataCreate(NSData *data, NSString * algorithm) {
@@ -54,7 +61,515 @@ id<MKTransportableData> MKTransportableDataCreate(NSData *data, NSString * algor
     return [ext.tedHelper createTransportableData:data algorithm:algorithm];
 }
 
+// only small strings are worth caching
+#define MKTransportableDataCacheMaxLength  4096
+
 id<MKTransportableData> MKTransportableDataParse(id ted) {
     MKFormatExtensions *ext = [MKFormatExtensions sharedInstance];
-    return [ext.tedHelper parseTransportableData:ted];
+    id<MKTransportableDataHelper> helper = ext.tedHelper;
+    MKLRUCache<NSString *, id<MKTransportableData>> *cache = ext.tedCache;
+    if (!cache || ![ted isKindOfClass:[NSString class]] ||
+        [ted length] > MKTransportableDataCacheMaxLength) {
+        return [helper parseTransportableData:ted];
+    }
+    id<MKTransportableData> res = [cache objectForKey:ted];
+    if (!res) {
+        res = [helper parseTransportableData:ted];
+        // only TEDs whose copies are independent, and not from a replaced helper
+        if (![res isKindOfClass:[MKTransportableData class]] || helper != ext.tedHelper) {
+            return res;
+        }
+        [cache setObject:res forKey:ted];
+    }
+    // the cached one is never handed out
+    return [(MKTransportableData *)res copy];
+}
+
+#pragma mark - Base TED
+
+static NSString *encode_data(NSData *data, MKTypeTag tag) {
+    switch (tag) {
+        case MKTypeTag_Base64:
+            return MKBase64Encode(data);
+        case MKTypeTag_Base58:
+            return MKBase58Encode(data);
+        case MKTypeTag_Hex:
+            return MKHexEncode(data);
+        default:
+            // algorithm not support
+            return nil;
+    }
+}
+
+static NSData *decode_data(NSString *encoded, MKTypeTag tag) {
+    switch (tag) {
+        case MKTypeTag_Base64:
+            return MKBase64Decode(encoded);
+        case MKTypeTag_Base58:
+            return MKBase58Decode(encoded);
+        case MKTypeTag_Hex:
+            return MKHexDecode(encoded);
+        default:
+            // algorithm not support, e.g. "base32,..." from a remote peer
+            return nil;
+    }
+}
+
+// big decoded data is kept as purgeable memory
+#define MKTransportableDataPurgeableSize  (64 * 1024)
+
+// view on purgeable data, in use until the view is released
+static NSData *pin_purgeable(NSPurgeableData *purgeable) {
+    return [[NSData alloc] initWithBytesNoCopy:(void *)purgeable.bytes
+                                        length:purgeable.length
+                                   deallocator:^(void *bytes, NSUInteger length) {
+        @synchronized (purgeable) {
+            [purgeable endContentAccess];
+        }
+    }];
+}
+
+// nil when the system has reclaimed it
+static NSData *pin_decoded(NSData *decoded) {
+    if (![decoded isKindOfClass:[NSPurgeableData class]]) {
+        return decoded;
+    }
+    NSPurgeableData *purgeable = (NSPurgeableData *)decoded;
+    BOOL available;
+    @synchronized (purgeable) {
+        available = [purgeable beginContentAccess];
+    }
+    return available ? pin_purgeable(purgeable) : nil;
+}
+
+// write all bytes
+static BOOL write_bytes(NSOutputStream *sink, const UInt8 *bytes, NSUInteger length) {
+    NSInteger cnt;
+    while (length > 0) {
+        cnt = [sink write:bytes maxLength:length];
+        if (cnt <= 0) {
+            return NO;
+        }
+        bytes += cnt;
+        length -= cnt;
+    }
+    return YES;
+}
+
+// multiple of 3, so base64 chunks join without padding
+#define MKTransportableDataChunkSize  (3 * 16 * 1024)
+
+static BOOL write_encoded(NSOutputStream *sink, NSData *data, MKTypeTag tag) {
+    const UInt8 *bytes = data.bytes;
+    NSUInteger length = data.length;
+    NSUInteger offset = 0;
+    NSUInteger size;
+    while (offset < length) {
+        size = MIN(MKTransportableDataChunkSize, length - offset);
+        @autoreleasepool {
+            // view on the original bytes, no copy
+            NSData *chunk = [[NSData alloc] initWithBytesNoCopy:(void *)(bytes + offset)
+                                                         length:size
+                                                   freeWhenDone:NO];
+            // through the current coder, which may be replaced
+            NSData *out = MKUTF8Encode(encode_data(chunk, tag));
+            if (!write_bytes(sink, out.bytes, out.length)) {
+                return NO;
+            }
+        }
+        offset += size;
+    }
+    return YES;
+}
+
+/*
+ *  Memoized values of a TED, shared by its copies
+ *  until one of them is changed
+ */
+@interface MKTransportableDataMemo : NSObject {
+    
+    os_unfair_lock _lock;
+    NSString *_body;      // encoded body (created from data)
+    NSData *_decoded;     // decoded data (parsed from string), purgeable if big
+    NSString *_string;    // encoded string
+}
+
+- (instancetype)initWithString:(nullable NSString *)string;
+
+@end
+
+@implementation MKTransportableDataMemo
+
+- (instancetype)initWithString:(nullable NSString *)string {
+    if (self = [super init]) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _body = nil;
+        _decoded = nil;
+        _string = string;
+    }
+    return self;
+}
+
+- (nullable NSString *)body {
+    os_unfair_lock_lock(&_lock);
+    NSString *body = _body;
+    os_unfair_lock_unlock(&_lock);
+    return body;
+}
+
+// the first one wins
+- (NSString *)keepBody:(NSString *)body {
+    os_unfair_lock_lock(&_lock);
+    if (!_body) {
+        _body = body;
+    }
+    body = _body;
+    os_unfair_lock_unlock(&_lock);
+    return body;
+}
+
+- (nullable NSData *)decoded {
+    os_unfair_lock_lock(&_lock);
+    NSData *decoded = _decoded;
+    os_unfair_lock_unlock(&_lock);
+    return decoded;
+}
+
+// replaces a reclaimed one
+- (void)keepDecoded:(NSData *)decoded {
+    os_unfair_lock_lock(&_lock);
+    _decoded = decoded;
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (nullable NSString *)string {
+    os_unfair_lock_lock(&_lock);
+    NSString *str = _string;
+    os_unfair_lock_unlock(&_lock);
+    return str;
+}
+
+// the first one wins
+- (NSString *)keepString:(NSString *)str {
+    os_unfair_lock_lock(&_lock);
+    if (!_string) {
+        _string = str;
+    }
+    str = _string;
+    os_unfair_lock_unlock(&_lock);
+    return str;
+}
+
+@end
+
+@interface MKTransportableData () {
+    
+    BOOL _plain;          // no header: "{BASE64_ENCODE}"
+    BOOL _mapped;         // map form: "{...}"
+    
+    MKTypeTag _tag;       // resolved on init and on change
+    
+    // a TED may be read by many threads, getters never write into the
+    // inner dictionary (except 'dictionary'), and these two are
+    // replaced on change, under the lock
+    os_unfair_lock _lock;
+    NSData *_data;        // original data (created from data)
+    MKTransportableDataMemo *_memo;
+}
+
+@end
+
+@implementation MKTransportableData
+
+- (instancetype)initWithDictionary:(NSDictionary *)dict {
+    if (self = [super initWithDictionary:dict]) {
+        _plain = NO;
+        _mapped = YES;
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _data = nil;
+        _memo = [[MKTransportableDataMemo alloc] initWithString:nil];
+        _tag = [self _resolveTag];
+    }
+    return self;
+}
+
+- (instancetype)initWithData:(NSData *)data algorithm:(nullable NSString *)name {
+    NSMutableDictionary *dict = [[NSMutableDictionary alloc] initWithCapacity:2];
+    [dict setObject:(name ? name : @"base64") forKey:@"algorithm"];
+    if (self = [super initWithDictionary:dict]) {
+        // encode lazily
+        _plain = name == nil;
+        _mapped = NO;
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _data = data;
+        _memo = [[MKTransportableDataMemo alloc] initWithString:nil];
+        _tag = [self _resolveTag];
+    }
+    return self;
+}
+
+- (instancetype)initWithString:(NSString *)string {
+    NSString *algorithm;
+    NSString *encoded;
+    NSRange comma = [string rangeOfString:@","];
+    if (comma.location == NSNotFound) {
+        // "{BASE64_ENCODE}"
+        algorithm = @"base64";
+        encoded = string;
+    } else {
+        // "base64,{BASE64_ENCODE}"
+        // "data:image/png;base64,{BASE64_ENCODE}"
+        NSString *header = [string substringToIndex:comma.location];
+        NSRange semicolon = [header rangeOfString:@";" options:NSBackwardsSearch];
+        if (semicolon.location == NSNotFound) {
+            algorithm = header;
+        } else {
+            algorithm = [header substringFromIndex:(semicolon.location + 1)];
+        }
+        encoded = [string substringFromIndex:(comma.location + 1)];
+    }
+    NSMutableDictionary *dict = [[NSMutableDictionary alloc] initWithCapacity:2];
+    [dict setObject:algorithm forKey:@"algorithm"];
+    [dict setObject:encoded forKey:@"data"];
+    if (self = [super initWithDictionary:dict]) {
+        // decode lazily, re-emit the original string
+        _plain = comma.location == NSNotFound;
+        _mapped = NO;
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _data = nil;
+        _memo = [[MKTransportableDataMemo alloc] initWithString:string];
+        _tag = [self _resolveTag];
+    }
+    return self;
+}
+
+- (id)copyWithZone:(nullable NSZone *)zone {
+    // own inner dictionary, so changing the copy won't touch this one;
+    // memoized values are shared until either of them changes
+    NSMutableDictionary *dict = [[super dictionary] mutableCopy];
+    MKTransportableData *ted = [[[self class] allocWithZone:zone] initWithDictionary:dict];
+    if (ted) {
+        ted->_plain = _plain;
+        ted->_mapped = _mapped;
+        ted->_tag = _tag;
+        os_unfair_lock_lock(&_lock);
+        ted->_data = _data;
+        ted->_memo = _memo;
+        os_unfair_lock_unlock(&_lock);
+    }
+    return ted;
+}
+
+- (MKTypeTag)_resolveTag {
+    NSString *algorithm = self.algorithm;
+    return algorithm ? MKTypeTagFromString(algorithm) : MKTypeTag_Base64;
+}
+
+- (nullable NSData *)_original {
+    os_unfair_lock_lock(&_lock);
+    NSData *data = _data;
+    os_unfair_lock_unlock(&_lock);
+    return data;
+}
+
+- (MKTransportableDataMemo *)_memo {
+    os_unfair_lock_lock(&_lock);
+    MKTransportableDataMemo *memo = _memo;
+    os_unfair_lock_unlock(&_lock);
+    return memo;
+}
+
+// encoded body, without header
+- (nullable NSString *)_encoded {
+    NSString *encoded = MKConvertString([super objectForKey:@"data"], nil);
+    NSData *data = encoded ? nil : [self _original];
+    if (!data) {
+        return encoded;
+    }
+    MKTransportableDataMemo *memo = [self _memo];
+    encoded = [memo body];
+    if (!encoded) {
+        // encode outside the lock, the first result wins
+        encoded = encode_data(data, _tag);
+        encoded = encoded ? [memo keepBody:encoded] : nil;
+    }
+    return encoded;
+}
+
+// Override
+- (NSString *)algorithm {
+    return [self stringForKey:@"algorithm" defaultValue:nil];
+}
+
+- (MKTypeTag)algorithmTag {
+    return _tag;
+}
+
+// Override
+- (NSData *)data {
+    NSData *data = [self _original];
+    if (data) {
+        return data;
+    }
+    MKTransportableDataMemo *memo = [self _memo];
+    data = pin_decoded([memo decoded]);
+    if (data) {
+        return data;
+    }
+    NSString *encoded = [self _encoded];
+    if (!encoded) {
+        return nil;
+    }
+    // decode once, kept with this TED until reclaimed
+    data = decode_data(encoded, _tag);
+    if (!data) {
+        return nil;
+    } else if (data.length < MKTransportableDataPurgeableSize) {
+        [memo keepDecoded:data];
+    } else {
+        // created in use, the returned view ends it
+        NSPurgeableData *purgeable = [[NSPurgeableData alloc] initWithData:data];
+        [memo keepDecoded:purgeable];
+        data = pin_purgeable(purgeable);
+    }
+    return data;
+}
+
+// Override
+- (NSString *)string {
+    if (_mapped) {
+        // mutable, not memoized
+        return MKJsonMapEncode([self dictionary]);
+    }
+    MKTransportableDataMemo *memo = [self _memo];
+    NSString *str = [memo string];
+    if (!str) {
+        NSString *encoded = [self _encoded];
+        if (!encoded) {
+            // algorithm not support
+            return @"";
+        } else if (_plain) {
+            str = encoded;
+        } else {
+            str = [NSString stringWithFormat:@"%@,%@", self.algorithm, encoded];
+        }
+        str = [memo keepString:str];
+    }
+    return str;
+}
+
+// Override
+- (NSObject *)object {
+    if (_mapped) {
+        return [self dictionary];
+    }
+    return [self string];
+}
+
+- (BOOL)writeToStream:(NSOutputStream *)sink {
+    MKTypeTag tag = _tag;
+    // keep the original data alive while streaming
+    NSData *data = _mapped || [super objectForKey:@"data"] ? nil : [self _original];
+    BOOL chunked = data && (tag == MKTypeTag_Base64 || tag == MKTypeTag_Hex);
+    if (chunked) {
+        // encoded already, write it directly
+        MKTransportableDataMemo *memo = [self _memo];
+        chunked = ![memo string] && ![memo body];
+    }
+    if (!chunked) {
+        NSData *utf8 = MKUTF8Encode([self string]);
+        return write_bytes(sink, utf8.bytes, utf8.length);
+    }
+    if (!_plain) {
+        NSData *header = MKUTF8Encode([self.algorithm stringByAppendingString:@","]);
+        if (!write_bytes(sink, header.bytes, header.length)) {
+            return NO;
+        }
+    }
+    return write_encoded(sink, data, tag);
+}
+
+#pragma mark MKDictionary
+
+// Override
+- (NSMutableDictionary *)dictionary {
+    NSMutableDictionary *dict = [super dictionary];
+    if ([dict objectForKey:@"data"] || ![self _original]) {
+        return dict;
+    }
+    // store the encoded body once, so callers get the real inner dictionary
+    NSString *encoded = [self _encoded];
+    if (encoded) {
+        os_unfair_lock_lock(&_lock);
+        if (![dict objectForKey:@"data"]) {
+            [dict setObject:encoded forKey:@"data"];
+        }
+        os_unfair_lock_unlock(&_lock);
+    }
+    return dict;
+}
+
+// Override
+- (NSMutableDictionary *)copyDictionary:(BOOL)deepCopy {
+    NSMutableDictionary *dict = [super copyDictionary:deepCopy];
+    NSString *encoded = [dict objectForKey:@"data"] ? nil : [self _encoded];
+    if (encoded) {
+        [dict setObject:encoded forKey:@"data"];
+    }
+    return dict;
+}
+
+// Override
+- (id)objectForKey:(NSString *)aKey {
+    if ([aKey isEqualToString:@"data"]) {
+        return [self _encoded];
+    }
+    return [super objectForKey:aKey];
+}
+
+- (void)_willChange:(NSString *)aKey {
+    if (![aKey isEqualToString:@"algorithm"]) {
+        return;
+    }
+    if (![super objectForKey:@"data"]) {
+        // keep the current body before dropping the original data
+        [super setObject:[self _encoded] forKey:@"data"];
+    }
+}
+
+- (void)_didChange:(NSString *)aKey {
+    if (![aKey isEqualToString:@"data"] && ![aKey isEqualToString:@"algorithm"]) {
+        return;
+    }
+    _tag = [self _resolveTag];
+    // copies keep the old memo
+    MKTransportableDataMemo *memo = [[MKTransportableDataMemo alloc] initWithString:nil];
+    os_unfair_lock_lock(&_lock);
+    _data = nil;
+    _memo = memo;
+    os_unfair_lock_unlock(&_lock);
+}
+
+// Override
+- (void)setObject:(id)anObject forKey:(NSString *)aKey {
+    [self _willChange:aKey];
+    [super setObject:anObject forKey:aKey];
+    [self _didChange:aKey];
+}
+
+// Override
+- (void)removeObjectForKey:(NSString *)aKey {
+    [self _willChange:aKey];
+    [super removeObjectForKey:aKey];
+    [self _didChange:aKey];
+}
+
+@end
+
+BOOL MKTransportableDataWrite(id<MKTransportableData> ted, NSOutputStream *sink) {
+    if ([ted isKindOfClass:[MKTransportableData class]]) {
+        return [(MKTransportableData *)ted writeToStream:sink];
+    }
+    NSData *utf8 = MKUTF8Encode(ted.string);
+    return write_bytes(sink, utf8.bytes, utf8.length);
 }
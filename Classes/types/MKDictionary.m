@@ -97,8 +97,9 @@
 }
 
 - (id)copyWithZone:(nullable NSZone *)zone {
+    // own inner dictionary, so changing the copy won't touch this one
     id dict = [[self class] allocWithZone:zone];
-    dict = [dict initWithDictionary:_storeDictionary];
+    dict = [dict initWithDictionary:[_storeDictionary mutableCopy]];
     return dict;
 }
 
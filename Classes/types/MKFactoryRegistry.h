@@ -0,0 +1,90 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKFactoryRegistry.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ *  Factory Registry
+ *  ~~~~~~~~~~~~~~~~
+ *  Name => factory map for helpers, published as immutable snapshots:
+ *
+ *  1. a writer copies the current snapshot, changes the copy, and swaps
+ *     it in (writers are serialized, registering is rare);
+ *  2. a reader takes the current snapshot and looks up in it without
+ *     locking; it waits only for a pointer swap, never for a copy;
+ *  3. a replaced snapshot is released when its last reader is done.
+ *
+ *  A helper can keep its factories in it, e.g.:
+ *
+ *      - (void)setSymmetricKeyFactory:(id<MKSymmetricKeyFactory>)factory
+ *                           algorithm:(NSString *)name {
+ *          [_factories setObject:factory forKey:name];
+ *      }
+ *
+ *      - (id<MKSymmetricKeyFactory>)getSymmetricKeyFactory:(NSString *)algorithm {
+ *          return [_factories objectForKey:algorithm];
+ *      }
+ */
+@interface MKFactoryRegistry<ObjectType> : NSObject
+
+/**
+ *  Current snapshot, never changes after returned
+ */
+@property (readonly, strong) NSDictionary<NSString *, ObjectType> *snapshot;
+
+- (nullable ObjectType)objectForKey:(NSString *)name;
+
+/**
+ *  Publish a new snapshot with the factory
+ *
+ * @param obj  - factory, nil to remove
+ * @param name - algorithm, type, ...
+ */
+- (void)setObject:(nullable ObjectType)obj forKey:(NSString *)name;
+
+/**
+ *  Publish a new snapshot with all of them (one swap for many factories)
+ *
+ * @param objects - factories
+ */
+- (void)addEntriesFromDictionary:(NSDictionary<NSString *, ObjectType> *)objects;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,106 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKFactoryRegistry.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <os/lock.h>
+
+#import "MKFactoryRegistry.h"
+
+@interface MKFactoryRegistry () {
+    
+    os_unfair_lock _lock;       // guards '_table' (pointer only)
+    os_unfair_lock _writeLock;  // one writer at a time
+    
+    NSDictionary *_table;
+}
+
+@end
+
+@implementation MKFactoryRegistry
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _writeLock = OS_UNFAIR_LOCK_INIT;
+        _table = @{};
+    }
+    return self;
+}
+
+- (NSDictionary *)snapshot {
+    NSDictionary *table;
+    os_unfair_lock_lock(&_lock);
+    table = _table;
+    os_unfair_lock_unlock(&_lock);
+    return table;
+}
+
+- (nullable id)objectForKey:(NSString *)name {
+    return [[self snapshot] objectForKey:name];
+}
+
+// copy, change, swap
+- (void)_update:(void (NS_NOESCAPE ^)(NSMutableDictionary *table))block {
+    os_unfair_lock_lock(&_writeLock);
+    NSMutableDictionary *table = [[self snapshot] mutableCopy];
+    block(table);
+    NSDictionary *next = [table copy];
+    // released on return, outside the locks (readers may still hold it)
+    NS_VALID_UNTIL_END_OF_SCOPE NSDictionary *prev;
+    os_unfair_lock_lock(&_lock);
+    prev = _table;
+    _table = next;
+    os_unfair_lock_unlock(&_lock);
+    os_unfair_lock_unlock(&_writeLock);
+}
+
+- (void)setObject:(nullable id)obj forKey:(NSString *)name {
+    [self _update:^(NSMutableDictionary *table) {
+        if (obj) {
+            [table setObject:obj forKey:name];
+        } else {
+            [table removeObjectForKey:name];
+        }
+    }];
+}
+
+- (void)addEntriesFromDictionary:(NSDictionary *)objects {
+    [self _update:^(NSMutableDictionary *table) {
+        [table addEntriesFromDictionary:objects];
+    }];
+}
+
+@end
@@ -0,0 +1,94 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKLRUCache.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ *  LRU Cache
+ *  ~~~~~~~~~
+ *  Bounded by count, the least recently used entry is evicted first;
+ *  entries can also expire after a time to live;
+ *  thread safe, with hit/miss counters for sizing.
+ */
+@interface MKLRUCache<KeyType, ObjectType> : NSObject
+
+@property (readonly, nonatomic) NSUInteger countLimit;
+
+@property (readonly, nonatomic) NSTimeInterval timeToLive;  // 0 means never expire
+
+@property (readonly) NSUInteger count;
+
+/**
+ *  Statistics
+ */
+@property (readonly) NSUInteger hits;
+@property (readonly) NSUInteger misses;
+@property (readonly) double hitRate;  // hits / (hits + misses)
+
+/**
+ *  Called with each entry dropped from the cache (evicted by limit,
+ *  expired, replaced by another object, or removed), outside the lock
+ */
+@property (copy, nullable) void (^evictionHandler)(KeyType key, ObjectType obj);
+
+- (instancetype)initWithCountLimit:(NSUInteger)limit;
+
+/**
+ *  Create cache with time to live
+ *
+ * @param limit - max count
+ * @param ttl   - seconds from set to expire, 0 means never
+ */
+- (instancetype)initWithCountLimit:(NSUInteger)limit
+                        timeToLive:(NSTimeInterval)ttl
+NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (nullable ObjectType)objectForKey:(KeyType)key;
+- (void)setObject:(ObjectType)obj forKey:(KeyType)key;
+
+- (void)removeObjectForKey:(KeyType)key;
+- (void)removeAllObjects;
+
+- (void)resetStatistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
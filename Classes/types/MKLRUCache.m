@@ -0,0 +1,276 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKLRUCache.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <os/lock.h>
+
+#import "MKLRUCache.h"
+
+@interface MKLRUNode : NSObject {
+    
+@public
+    id _key;
+    id _value;
+    CFAbsoluteTime _expires;  // 0 means never
+    
+    __unsafe_unretained MKLRUNode *_prev;
+    MKLRUNode *_next;
+}
+
+@end
+
+@implementation MKLRUNode
+
+@end
+
+@interface MKLRUCache () {
+    
+    os_unfair_lock _lock;
+    
+    NSMutableDictionary *_nodes;
+    
+    MKLRUNode *_head;                     // most recently used
+    __unsafe_unretained MKLRUNode *_tail; // least recently used
+    
+    NSUInteger _hits;
+    NSUInteger _misses;
+}
+
+@end
+
+@implementation MKLRUCache
+
+- (instancetype)initWithCountLimit:(NSUInteger)limit {
+    return [self initWithCountLimit:limit timeToLive:0];
+}
+
+/* designated initializer */
+- (instancetype)initWithCountLimit:(NSUInteger)limit
+                        timeToLive:(NSTimeInterval)ttl {
+    NSAssert(limit > 0, @"count limit error: %lu", limit);
+    if (self = [super init]) {
+        _countLimit = limit;
+        _timeToLive = ttl;
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _nodes = [[NSMutableDictionary alloc] initWithCapacity:limit];
+        _head = nil;
+        _tail = nil;
+        _hits = 0;
+        _misses = 0;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@ count=\"%lu/%lu\" hits=%lu misses=%lu />",
+            [self class], self.count, _countLimit, self.hits, self.misses];
+}
+
+#pragma mark List (locked)
+
+- (void)_unlink:(MKLRUNode *)node {
+    MKLRUNode *next = node->_next;
+    if (node->_prev) {
+        node->_prev->_next = next;
+    } else {
+        _head = next;
+    }
+    if (next) {
+        next->_prev = node->_prev;
+    } else {
+        _tail = node->_prev;
+    }
+    node->_prev = nil;
+    node->_next = nil;
+}
+
+- (void)_pushFront:(MKLRUNode *)node {
+    node->_prev = nil;
+    node->_next = _head;
+    if (_head) {
+        _head->_prev = node;
+    } else {
+        _tail = node;
+    }
+    _head = node;
+}
+
+// call eviction handler for dropped nodes (unlocked)
+- (void)_didDrop:(NSArray<MKLRUNode *> *)nodes {
+    void (^handler)(id, id) = self.evictionHandler;
+    if (!handler) {
+        return;
+    }
+    for (MKLRUNode *node in nodes) {
+        handler(node->_key, node->_value);
+    }
+}
+
+#pragma mark Access
+
+- (NSUInteger)count {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger count = [_nodes count];
+    os_unfair_lock_unlock(&_lock);
+    return count;
+}
+
+- (NSUInteger)hits {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger hits = _hits;
+    os_unfair_lock_unlock(&_lock);
+    return hits;
+}
+
+- (NSUInteger)misses {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger misses = _misses;
+    os_unfair_lock_unlock(&_lock);
+    return misses;
+}
+
+- (double)hitRate {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger total = _hits + _misses;
+    double rate = total > 0 ? (double)_hits / total : 0;
+    os_unfair_lock_unlock(&_lock);
+    return rate;
+}
+
+- (void)resetStatistics {
+    os_unfair_lock_lock(&_lock);
+    _hits = 0;
+    _misses = 0;
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (nullable id)objectForKey:(id)key {
+    id value = nil;
+    MKLRUNode *expired = nil;
+    os_unfair_lock_lock(&_lock);
+    MKLRUNode *node = [_nodes objectForKey:key];
+    if (node && node->_expires > 0 && node->_expires < CFAbsoluteTimeGetCurrent()) {
+        expired = node;
+        [self _unlink:node];
+        [_nodes removeObjectForKey:key];
+        node = nil;
+    }
+    if (node) {
+        if (node != _head) {
+            [self _unlink:node];
+            [self _pushFront:node];
+        }
+        value = node->_value;
+        ++_hits;
+    } else {
+        ++_misses;
+    }
+    os_unfair_lock_unlock(&_lock);
+    if (expired) {
+        [self _didDrop:@[expired]];
+    }
+    return value;
+}
+
+- (void)setObject:(id)obj forKey:(id)key {
+    NSAssert(obj, @"cache value should not be empty: %@", key);
+    MKLRUNode *evicted = nil;
+    CFAbsoluteTime expires = _timeToLive > 0 ? CFAbsoluteTimeGetCurrent() + _timeToLive : 0;
+    os_unfair_lock_lock(&_lock);
+    MKLRUNode *node = [_nodes objectForKey:key];
+    if (node) {
+        // update
+        if (node->_value != obj) {
+            evicted = [[MKLRUNode alloc] init];
+            evicted->_key = node->_key;
+            evicted->_value = node->_value;
+        }
+        node->_value = obj;
+        node->_expires = expires;
+        if (node != _head) {
+            [self _unlink:node];
+            [self _pushFront:node];
+        }
+    } else {
+        node = [[MKLRUNode alloc] init];
+        node->_key = key;
+        node->_value = obj;
+        node->_expires = expires;
+        [_nodes setObject:node forKey:key];
+        [self _pushFront:node];
+        if ([_nodes count] > _countLimit) {
+            evicted = _tail;
+            [self _unlink:evicted];
+            [_nodes removeObjectForKey:evicted->_key];
+        }
+    }
+    os_unfair_lock_unlock(&_lock);
+    if (evicted) {
+        [self _didDrop:@[evicted]];
+    }
+}
+
+- (void)removeObjectForKey:(id)key {
+    os_unfair_lock_lock(&_lock);
+    MKLRUNode *node = [_nodes objectForKey:key];
+    if (node) {
+        [self _unlink:node];
+        [_nodes removeObjectForKey:key];
+    }
+    os_unfair_lock_unlock(&_lock);
+    if (node) {
+        [self _didDrop:@[node]];
+    }
+}
+
+- (void)removeAllObjects {
+    os_unfair_lock_lock(&_lock);
+    NSMutableDictionary *nodes = _nodes;
+    _nodes = [[NSMutableDictionary alloc] initWithCapacity:_countLimit];
+    // break the chain without recursive release
+    MKLRUNode *node = _head;
+    while (node) {
+        MKLRUNode *next = node->_next;
+        node->_next = nil;
+        node = next;
+    }
+    _head = nil;
+    _tail = nil;
+    os_unfair_lock_unlock(&_lock);
+    [self _didDrop:[nodes allValues]];
+}
+
+@end
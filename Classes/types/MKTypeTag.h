@@ -0,0 +1,87 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKTypeTag.h
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ *  @enum MKTypeTag
+ *
+ *  @abstract Compact tags for TED encode algorithms.
+ *
+ *  @discussion Names are mapped to tags once when parsing, later dispatch
+ *      can switch on the tag without comparing strings.
+ *      Names are case-sensitive, one name for each tag; other names get
+ *      MKTypeTag_Unknown, and should be handled by the original string.
+ */
+typedef NS_ENUM(UInt8, MKTypeTag) {
+    
+    MKTypeTag_Unknown    = 0,
+    
+    MKTypeTag_Base64     = 1,    // "base64"
+    MKTypeTag_Base58     = 2,    // "base58"
+    MKTypeTag_Hex        = 3,    // "hex"
+    
+    MKTypeTagCount
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Get tag for name (exact match, no string compare)
+ *
+ * @param name - encode algorithm
+ * @return MKTypeTag_Unknown for other names
+ */
+MKTypeTag MKTypeTagFromString(NSString * _Nullable name);
+
+/**
+ *  Get name for tag
+ *
+ * @param tag - known tag
+ * @return nil for MKTypeTag_Unknown
+ */
+NSString * _Nullable MKTypeTagToString(MKTypeTag tag);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+NS_ASSUME_NONNULL_END
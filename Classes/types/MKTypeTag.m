@@ -0,0 +1,86 @@
+// license: https://mit-license.org
+//
+//  Ming-Ke-Ming : Decentralized User Identity Authentication
+//
+//                               Written in 2026 by Moky <albert.moky@gmail.com>
+//
+// =============================================================================
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Albert Moky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// =============================================================================
+//
+//  MKTypeTag.m
+//  MingKeMing
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import "MKTypeTag.h"
+
+// pack up to 8 ASCII chars into an integer
+#define MK_PACK(a, b, c, d, e, f, g, h)                                        \
+                ((UInt64)(a)       | (UInt64)(b) << 8  |                       \
+                 (UInt64)(c) << 16 | (UInt64)(d) << 24 |                       \
+                 (UInt64)(e) << 32 | (UInt64)(f) << 40 |                       \
+                 (UInt64)(g) << 48 | (UInt64)(h) << 56)
+
+static inline UInt64 pack_name(NSString *name) {
+    NSUInteger len = name.length;
+    if (len == 0 || len > 8) {
+        return 0;
+    }
+    unichar chars[8];
+    [name getCharacters:chars range:NSMakeRange(0, len)];
+    UInt64 key = 0;
+    unichar ch;
+    for (NSUInteger i = 0; i < len; ++i) {
+        ch = chars[i];
+        if (ch == 0 || ch > 0x7F) {
+            return 0;
+        }
+        key |= (UInt64)ch << (i * 8);
+    }
+    return key;
+}
+
+MKTypeTag MKTypeTagFromString(NSString *name) {
+    switch (pack_name(name)) {
+        case MK_PACK('b', 'a', 's', 'e', '6', '4', 0, 0):
+            return MKTypeTag_Base64;
+        case MK_PACK('b', 'a', 's', 'e', '5', '8', 0, 0):
+            return MKTypeTag_Base58;
+        case MK_PACK('h', 'e', 'x', 0, 0, 0, 0, 0):
+            return MKTypeTag_Hex;
+        default:
+            return MKTypeTag_Unknown;
+    }
+}
+
+NSString *MKTypeTagToString(MKTypeTag tag) {
+    switch (tag) {
+        case MKTypeTag_Base64:   return @"base64";
+        case MKTypeTag_Base58:   return @"base58";
+        case MKTypeTag_Hex:      return @"hex";
+        default:                 return nil;
+    }
+}
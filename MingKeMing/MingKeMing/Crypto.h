@@ -40,9 +40,11 @@
 
 #import <MingKeMing/MKCryptographyKey.h>
 #import <MingKeMing/MKSymmetricKey.h>
+#import <MingKeMing/MKAESStream.h>
 #import <MingKeMing/MKAsymmetricKey.h>
 #import <MingKeMing/MKPublicKey.h>
 #import <MingKeMing/MKPrivateKey.h>
+#import <MingKeMing/MKPrivateKeyPool.h>
 //#import <MingKeMing/MKCryptoHelpers.h>  // -> "Ext.h"
 
 #endif /* ! __MKM_CRYPTO__ */
@@ -36,8 +36,13 @@
 //#import <MingKeMing/MKDigester.h>       // -> "Digest.h"
 #import <MingKeMing/MKDataCoder.h>
 #import <MingKeMing/MKDataParser.h>
+#import <MingKeMing/MKJSONReader.h>
+#import <MingKeMing/MKJSONDictionary.h>
+#import <MingKeMing/MKCanonicalJSON.h>
 #import <MingKeMing/MKTransportableData.h>
 #import <MingKeMing/MKPortableNetworkFile.h>
+#import <MingKeMing/MKPortableNetworkFileStream.h>
+#import <MingKeMing/MKPortableNetworkFileCache.h>
 //#import <MingKeMing/MKFormatHelpers.h>  // -> "Ext.h"
 
 #endif /* ! __MKM_FORMAT__ */
@@ -44,6 +44,7 @@
 #import <MingKeMing/MKMBroadcast.h>
 #import <MingKeMing/MKMMeta.h>
 #import <MingKeMing/MKMTai.h>
+#import <MingKeMing/MKMVerifier.h>
 //#import <MingKeMing/MKMAccountHelpers.h>    // -> "Ext.h"
 //#import <MingKeMing/MKMSharedExtensions.h>  // -> "Ext.h"
 
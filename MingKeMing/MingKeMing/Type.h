@@ -38,5 +38,8 @@
 #import <MingKeMing/MKWrapper.h>
 #import <MingKeMing/MKDictionary.h>
 #import <MingKeMing/MKString.h>
+#import <MingKeMing/MKLRUCache.h>
+#import <MingKeMing/MKFactoryRegistry.h>
+#import <MingKeMing/MKTypeTag.h>
 
 #endif /* ! __MKM_TYPES__ */
@@ -0,0 +1,171 @@
+//
+//  MKAESStreamTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Format.h>
+#import <MingKeMing/Crypto.h>
+
+@interface MKTestAESBase64 : NSObject <MKDataCoder>
+
+@end
+
+@implementation MKTestAESBase64
+
+- (NSString *)encode:(NSData *)data {
+    return [data base64EncodedStringWithOptions:0];
+}
+
+- (nullable NSData *)decode:(NSString *)string {
+    return [[NSData alloc] initWithBase64EncodedString:string options:0];
+}
+
+@end
+
+@interface MKAESStreamTests : XCTestCase
+
+@end
+
+@implementation MKAESStreamTests
+
+- (void)setUp {
+    [MKBase64 setCoder:[[MKTestAESBase64 alloc] init]];
+}
+
+static NSData *random_data(NSUInteger length) {
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:length];
+    arc4random_buf(data.mutableBytes, length);
+    return data;
+}
+
+// run all data through the stream in odd sized chunks
+static NSData *run_stream(MKAESStream *stream, NSData *input) {
+    NSMutableData *output = [[NSMutableData alloc] init];
+    NSUInteger offset = 0, size;
+    while (offset < input.length) {
+        size = MIN(1000, input.length - offset);
+        [output appendData:[stream update:[input subdataWithRange:NSMakeRange(offset, size)]]];
+        offset += size;
+    }
+    NSData *last = [stream finish];
+    if (!last) {
+        return nil;
+    }
+    [output appendData:last];
+    return output;
+}
+
+static NSDictionary *params_to_dict(const MKCipherParams *params) {
+    NSData *iv = [[NSData alloc] initWithBytes:params->iv length:params->ivLength];
+    NSData *tag = [[NSData alloc] initWithBytes:params->tag length:params->tagLength];
+    return @{@"IV": MKBase64Encode(iv), @"tag": MKBase64Encode(tag)};
+}
+
+- (void)testStreamRoundTrip {
+    NSData *key = random_data(32);
+    NSData *plaintext = random_data(10 * 1024 + 7);
+    NSMutableDictionary *params = [[NSMutableDictionary alloc] init];
+    NSData *ciphertext = run_stream([MKAESStream encryptStreamWithKey:key params:params], plaintext);
+    XCTAssertEqual(ciphertext.length, plaintext.length);
+    XCTAssertNotEqualObjects(ciphertext, plaintext);
+    MKAESStream *stream = [MKAESStream decryptStreamWithKey:key params:params];
+    XCTAssertEqualObjects(run_stream(stream, ciphertext), plaintext);
+    XCTAssertEqualObjects(MKBase64Encode(stream.tag), [params objectForKey:@"tag"]);
+}
+
+- (void)testStreamRejectsTampered {
+    NSData *key = random_data(16);
+    NSMutableDictionary *params = [[NSMutableDictionary alloc] init];
+    NSMutableData *ciphertext;
+    ciphertext = [run_stream([MKAESStream encryptStreamWithKey:key params:params], random_data(100)) mutableCopy];
+    ((UInt8 *)ciphertext.mutableBytes)[50] ^= 0x80;
+    XCTAssertNil(run_stream([MKAESStream decryptStreamWithKey:key params:params], ciphertext));
+    // no tag, no stream
+    XCTAssertNil([MKAESStream decryptStreamWithKey:key params:@{@"IV": [params objectForKey:@"IV"]}]);
+    // bad key size
+    XCTAssertNil([MKAESStream encryptStreamWithKey:random_data(20) params:params]);
+}
+
+- (void)testOneShotSameFormat {
+    NSData *key = random_data(24);
+    NSData *plaintext = random_data(4096 + 3);
+    NSMutableData *buffer = [plaintext mutableCopy];
+    MKCipherParams params;
+    // in place
+    NSInteger len = MKAESEncryptInto(key.bytes, key.length, buffer.bytes, buffer.length,
+                                     buffer.mutableBytes, buffer.length, &params);
+    XCTAssertEqual(len, plaintext.length);
+    XCTAssertNotEqualObjects(buffer, plaintext);
+    // decrypted by the stream
+    MKAESStream *stream = [MKAESStream decryptStreamWithKey:key params:params_to_dict(&params)];
+    XCTAssertEqualObjects(run_stream(stream, buffer), plaintext);
+    // and by itself
+    len = MKAESDecryptInto(key.bytes, key.length, buffer.bytes, buffer.length,
+                           buffer.mutableBytes, buffer.length, &params);
+    XCTAssertEqual(len, plaintext.length);
+    XCTAssertEqualObjects(buffer, plaintext);
+}
+
+- (void)testOneShotRejects {
+    NSData *key = random_data(32);
+    NSMutableData *buffer = [random_data(64) mutableCopy];
+    MKCipherParams params;
+    XCTAssertEqual(MKAESEncryptInto(key.bytes, 20, buffer.bytes, buffer.length,
+                                    buffer.mutableBytes, buffer.length, &params), -1);
+    XCTAssertEqual(MKAESEncryptInto(key.bytes, key.length, buffer.bytes, buffer.length,
+                                    buffer.mutableBytes, buffer.length - 1, &params), -1);
+    XCTAssertEqual(MKAESEncryptInto(key.bytes, key.length, buffer.bytes, buffer.length,
+                                    buffer.mutableBytes, buffer.length, &params), 64);
+    params.tag[0] ^= 0x01;
+    XCTAssertEqual(MKAESDecryptInto(key.bytes, key.length, buffer.bytes, buffer.length,
+                                    buffer.mutableBytes, buffer.length, &params), -1);
+}
+
+- (void)testContextMatchesOneShot {
+    NSData *key = random_data(32);
+    MKAESContext *context = [[MKAESContext alloc] initWithKey:key];
+    XCTAssertNotNil(context);
+    NSData *plaintext = random_data(3000);
+    dispatch_apply(64, DISPATCH_APPLY_AUTO, ^(size_t iteration) {
+        NSMutableData *buffer = [plaintext mutableCopy];
+        MKCipherParams params;
+        NSInteger len = [context encrypt:buffer.bytes length:buffer.length
+                                  output:buffer.mutableBytes capacity:buffer.length
+                                  params:&params];
+        XCTAssertEqual(len, plaintext.length);
+        len = MKAESDecryptInto(key.bytes, key.length, buffer.bytes, buffer.length,
+                               buffer.mutableBytes, buffer.length, &params);
+        XCTAssertEqual(len, plaintext.length);
+        XCTAssertEqualObjects(buffer, plaintext);
+    });
+}
+
+- (void)testContextDecrypt {
+    XCTAssertNil([[MKAESContext alloc] initWithKey:random_data(20)]);
+    NSData *key = random_data(16);
+    MKAESContext *context = [[MKAESContext alloc] initWithKey:key];
+    NSData *plaintext = random_data(777);
+    NSMutableData *buffer = [plaintext mutableCopy];
+    MKCipherParams params;
+    MKAESEncryptInto(key.bytes, key.length, buffer.bytes, buffer.length,
+                     buffer.mutableBytes, buffer.length, &params);
+    NSData *ciphertext = [buffer copy];
+    // tag checked before touching the buffer
+    params.tag[31] ^= 0x01;
+    XCTAssertEqual([context decrypt:buffer.bytes length:buffer.length
+                             output:buffer.mutableBytes capacity:buffer.length
+                             params:&params], -1);
+    XCTAssertEqualObjects(buffer, ciphertext);
+    params.tag[31] ^= 0x01;
+    XCTAssertEqual([context decrypt:buffer.bytes length:buffer.length
+                             output:buffer.mutableBytes capacity:buffer.length
+                             params:&params], 777);
+    XCTAssertEqualObjects(buffer, plaintext);
+}
+
+@end
@@ -0,0 +1,100 @@
+//
+//  MKCanonicalJSONTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Format.h>
+
+// marks output of the plain coder
+@interface MKTestPlainCoder : NSObject <MKObjectCoder>
+
+@end
+
+@implementation MKTestPlainCoder
+
+- (NSString *)encode:(id)object {
+    return @"plain";
+}
+
+- (nullable id)decode:(NSString *)string {
+    return nil;
+}
+
+@end
+
+@interface MKCanonicalJSONTests : XCTestCase
+
+@property (strong, nonatomic) MKCanonicalMapCoder *coder;
+
+@end
+
+@implementation MKCanonicalJSONTests
+
+- (void)setUp {
+    self.coder = [[MKCanonicalMapCoder alloc] init];
+}
+
+- (void)testSortedKeysNoSpaces {
+    NSDictionary *info = @{@"b": @[@1, @2.5, @YES], @"a": @"x", @"c": [NSNull null]};
+    XCTAssertEqualObjects([self.coder encode:info],
+                          @"{\"a\":\"x\",\"b\":[1,2.5,true],\"c\":null}");
+}
+
+- (void)testSameOutputForEqualMaps {
+    NSMutableDictionary *one = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary *two = [[NSMutableDictionary alloc] init];
+    // same fields, inserted in opposite orders
+    for (NSUInteger i = 0; i < 64; ++i) {
+        [one setObject:@(i) forKey:[NSString stringWithFormat:@"k%lu", i]];
+        [two setObject:@(63 - i) forKey:[NSString stringWithFormat:@"k%lu", 63 - i]];
+    }
+    XCTAssertEqualObjects([self.coder encodeData:one], [self.coder encodeData:two]);
+}
+
+- (void)testEscapes {
+    NSDictionary *info = @{@"s": @"\"\\\n\x01中"};
+    XCTAssertEqualObjects([self.coder encode:info], @"{\"s\":\"\\\"\\\\\\n\\u0001中\"}");
+}
+
+- (void)testUnpairedSurrogate {
+    unichar chars[] = {'a', 0xD800, 'b'};
+    NSString *bad = [NSString stringWithCharacters:chars length:3];
+    NSString *json = [self.coder encode:@{@"s": bad}];
+    XCTAssertEqualObjects(json, @"{\"s\":\"a\\ud800b\"}");
+}
+
+- (void)testRejectInvalid {
+    NSMutableData *buffer = [[NSMutableData alloc] initWithBytes:"x" length:1];
+    XCTAssertFalse(MKCanonicalJSONAppend(@{@"d": [NSDate date]}, buffer));
+    XCTAssertFalse([self.coder encode:@{@1: @"number key"} appendTo:buffer]);
+    XCTAssertFalse([MKJSONMap encodeCanonical:@{@"n": @(NAN)} appendTo:buffer]);
+    XCTAssertEqual(buffer.length, 1);
+    XCTAssertNil([MKJSONMap encodeCanonicalData:@{@"n": @(NAN)}]);
+}
+
+- (void)testInvalidFallsBackToPlainCoder {
+    id<MKObjectCoder> plain = [MKJSON getCoder];
+    [MKJSON setCoder:[[MKTestPlainCoder alloc] init]];
+    // never nil, the plain coder decides what to do with it
+    NSDictionary *info = @{@"n": @(NAN)};
+    XCTAssertEqualObjects([self.coder encode:info], @"plain");
+    XCTAssertEqualObjects([self.coder encodeData:info], [@"plain" dataUsingEncoding:NSUTF8StringEncoding]);
+    [MKJSON setCoder:plain];
+}
+
+- (void)testCanonicalPerCall {
+    // whatever coder is set for MKJSONMap
+    NSDictionary *info = @{@"b": @2, @"a": @1};
+    NSData *json = [MKJSONMap encodeCanonicalData:info];
+    XCTAssertEqualObjects(json, [@"{\"a\":1,\"b\":2}" dataUsingEncoding:NSUTF8StringEncoding]);
+    NSMutableData *buffer = [[NSMutableData alloc] initWithBytes:"[" length:1];
+    XCTAssertTrue([MKJSONMap encodeCanonical:info appendTo:buffer]);
+    XCTAssertEqualObjects(buffer, [@"[{\"a\":1,\"b\":2}" dataUsingEncoding:NSUTF8StringEncoding]);
+}
+
+@end
@@ -0,0 +1,128 @@
+//
+//  MKEncryptFanOutTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <CommonCrypto/CommonDigest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Digest.h>
+#import <MingKeMing/Crypto.h>
+
+@interface MKTestFanOutSHA256 : NSObject <MKMessageDigester>
+
+@end
+
+@implementation MKTestFanOutSHA256
+
+- (NSData *)digest:(NSData *)data {
+    UInt8 md[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, md);
+    return [[NSData alloc] initWithBytes:md length:sizeof(md)];
+}
+
+@end
+
+// ciphertext = key data + plaintext, counting calls
+@interface MKTestFanOutKey : MKDictionary <MKEncryptKey>
+
+@end
+
+@implementation MKTestFanOutKey
+
+static NSUInteger s_encrypt_count = 0;
+
+- (NSString *)algorithm {
+    return [self stringForKey:@"algorithm" defaultValue:@""];
+}
+
+- (NSData *)data {
+    return [[self stringForKey:@"data" defaultValue:@""] dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (NSData *)encrypt:(NSData *)plaintext extra:(nullable NSMutableDictionary *)params {
+    @synchronized ([MKTestFanOutKey class]) {
+        s_encrypt_count += 1;
+    }
+    NSMutableData *out = [[NSMutableData alloc] initWithData:self.data];
+    [out appendData:plaintext];
+    return out;
+}
+
+- (nullable id<MKCipherStream>)encryptStream:(nullable NSMutableDictionary *)params {
+    return nil;
+}
+
+@end
+
+@interface MKEncryptFanOutTests : XCTestCase
+
+@end
+
+@implementation MKEncryptFanOutTests
+
+- (void)setUp {
+    [MKSHA256 setDigester:[[MKTestFanOutSHA256 alloc] init]];
+    s_encrypt_count = 0;
+}
+
+static MKTestFanOutKey *new_key(NSDictionary *info) {
+    return [[MKTestFanOutKey alloc] initWithDictionary:info];
+}
+
+- (void)testSharedKeysEncryptedOnce {
+    NSData *plaintext = [@"group key" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableDictionary *keys = [[NSMutableDictionary alloc] init];
+    for (NSUInteger i = 0; i < 1000; ++i) {
+        NSString *pwd = [NSString stringWithFormat:@"key-%lu", i % 10];
+        [keys setObject:new_key(@{@"algorithm": @"TEST", @"data": pwd})
+                 forKey:[NSString stringWithFormat:@"member-%lu", i]];
+    }
+    NSDictionary *results = MKEncryptFanOut(plaintext, keys);
+    XCTAssertEqual(results.count, 1000);
+    XCTAssertEqual(s_encrypt_count, 10);
+    NSData *expected = [@"key-7group key" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertEqualObjects([results objectForKey:@"member-17"], expected);
+}
+
+- (void)testSameDataOtherAlgorithm {
+    NSData *plaintext = [@"x" dataUsingEncoding:NSUTF8StringEncoding];
+    NSDictionary *keys = @{
+        @"a": new_key(@{@"algorithm": @"ONE", @"data": @"pwd"}),
+        @"b": new_key(@{@"algorithm": @"TWO", @"data": @"pwd"}),
+        // same bytes when joined without length
+        @"c": new_key(@{@"algorithm": @"ONEp", @"data": @"wd"}),
+    };
+    XCTAssertEqual(MKEncryptFanOut(plaintext, keys).count, 3);
+    XCTAssertEqual(s_encrypt_count, 3);
+}
+
+- (void)testKeysWithParamsNotShared {
+    NSData *plaintext = [@"x" dataUsingEncoding:NSUTF8StringEncoding];
+    NSDictionary *keys = @{
+        @"a": new_key(@{@"algorithm": @"TEST", @"data": @"pwd"}),
+        @"b": new_key(@{@"algorithm": @"TEST", @"data": @"pwd"}),
+        @"c": new_key(@{@"algorithm": @"TEST", @"data": @"pwd", @"mode": @"CBC"}),
+        @"d": new_key(@{@"algorithm": @"TEST", @"data": @"pwd", @"mode": @"CBC"}),
+    };
+    XCTAssertEqual(MKEncryptFanOut(plaintext, keys).count, 4);
+    XCTAssertEqual(s_encrypt_count, 3);
+}
+
+- (void)testManyDistinctKeys {
+    NSData *plaintext = [@"x" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableDictionary *keys = [[NSMutableDictionary alloc] init];
+    for (NSUInteger i = 0; i < 20000; ++i) {
+        NSString *pwd = [NSString stringWithFormat:@"key-%lu", i];
+        [keys setObject:new_key(@{@"algorithm": @"TEST", @"data": pwd}) forKey:@(i)];
+    }
+    [self measureBlock:^{
+        XCTAssertEqual(MKEncryptFanOut(plaintext, keys).count, 20000);
+    }];
+}
+
+@end
@@ -0,0 +1,78 @@
+//
+//  MKExtensionsTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Format.h>
+#import <MingKeMing/Crypto.h>
+#import <MingKeMing/Ext.h>
+
+@interface MKTestStressHelper : NSObject <MKSymmetricKeyHelper>
+
+@property (nonatomic) NSUInteger tag;
+
+@end
+
+@implementation MKTestStressHelper
+
+- (void)setSymmetricKeyFactory:(id<MKSymmetricKeyFactory>)factory algorithm:(NSString *)name {
+}
+
+- (nullable id<MKSymmetricKeyFactory>)getSymmetricKeyFactory:(NSString *)algorithm {
+    return nil;
+}
+
+- (nullable id<MKSymmetricKey>)generateSymmetricKey:(NSString *)algorithm {
+    return nil;
+}
+
+- (nullable id<MKSymmetricKey>)parseSymmetricKey:(nullable id)key {
+    return nil;
+}
+
+@end
+
+@interface MKExtensionsTests : XCTestCase
+
+@end
+
+@implementation MKExtensionsTests
+
+// replace helpers and caches while other threads read them
+- (void)testReplaceWhileReading {
+    MKCryptoExtensions *crypto = [MKCryptoExtensions sharedInstance];
+    MKFormatExtensions *format = [MKFormatExtensions sharedInstance];
+    id<MKSymmetricKeyHelper> originalHelper = crypto.symmetricHelper;
+    MKLRUCache *originalCache = format.tedCache;
+    crypto.symmetricHelper = [[MKTestStressHelper alloc] init];
+    format.tedCache = [[MKLRUCache alloc] initWithCountLimit:1];
+    dispatch_apply(100000, DISPATCH_APPLY_AUTO, ^(size_t iteration) {
+        @autoreleasepool {
+            if (iteration % 4 == 0) {
+                MKTestStressHelper *helper = [[MKTestStressHelper alloc] init];
+                helper.tag = iteration;
+                crypto.symmetricHelper = helper;
+                format.tedCache = [[MKLRUCache alloc] initWithCountLimit:(iteration + 1)];
+            } else {
+                MKTestStressHelper *helper = (MKTestStressHelper *)crypto.symmetricHelper;
+                XCTAssertTrue(helper.tag % 4 == 0);
+                XCTAssertNil([helper parseSymmetricKey:@{}]);
+                MKLRUCache *cache = format.tedCache;
+                XCTAssertEqual(cache.countLimit % 4, 1);
+                // also through the shared facade
+                id<MKSymmetricKeyHelper> shared = [MKSharedCryptoExtensions sharedInstance].symmetricHelper;
+                XCTAssertTrue([shared isKindOfClass:[MKTestStressHelper class]]);
+            }
+        }
+    });
+    crypto.symmetricHelper = originalHelper;
+    format.tedCache = originalCache;
+}
+
+@end
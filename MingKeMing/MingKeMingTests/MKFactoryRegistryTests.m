@@ -0,0 +1,167 @@
+//
+//  MKFactoryRegistryTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <stdatomic.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Crypto.h>
+
+@interface MKTestRegistryFactory : NSObject <MKSymmetricKeyFactory>
+
+@property (nonatomic) NSUInteger version;
+
+@end
+
+@implementation MKTestRegistryFactory
+
+- (id<MKSymmetricKey>)generateSymmetricKey {
+    return nil;
+}
+
+- (nullable id<MKSymmetricKey>)parseSymmetricKey:(NSDictionary *)key {
+    return nil;
+}
+
+@end
+
+// keeps its factories in a registry
+@interface MKTestRegistryHelper : NSObject <MKSymmetricKeyHelper>
+
+@property (strong, nonatomic) MKFactoryRegistry<id<MKSymmetricKeyFactory>> *factories;
+
+@end
+
+@implementation MKTestRegistryHelper
+
+- (instancetype)init {
+    if (self = [super init]) {
+        self.factories = [[MKFactoryRegistry alloc] init];
+    }
+    return self;
+}
+
+- (void)setSymmetricKeyFactory:(id<MKSymmetricKeyFactory>)factory algorithm:(NSString *)name {
+    [self.factories setObject:factory forKey:name];
+}
+
+- (nullable id<MKSymmetricKeyFactory>)getSymmetricKeyFactory:(NSString *)algorithm {
+    return [self.factories objectForKey:algorithm];
+}
+
+- (nullable id<MKSymmetricKey>)generateSymmetricKey:(NSString *)algorithm {
+    return [[self getSymmetricKeyFactory:algorithm] generateSymmetricKey];
+}
+
+- (nullable id<MKSymmetricKey>)parseSymmetricKey:(nullable id)key {
+    NSString *algorithm = [key objectForKey:@"algorithm"];
+    return algorithm ? [[self getSymmetricKeyFactory:algorithm] parseSymmetricKey:key] : nil;
+}
+
+@end
+
+@interface MKFactoryRegistryTests : XCTestCase
+
+@property (strong, nonatomic, nullable) id<MKSymmetricKeyHelper> originalHelper;
+@property (strong, nonatomic, nullable) MKLRUCache *originalCache;
+
+@end
+
+@implementation MKFactoryRegistryTests
+
+- (void)setUp {
+    MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
+    self.originalHelper = ext.symmetricHelper;
+    self.originalCache = ext.symmetricKeyCache;
+    ext.symmetricKeyCache = nil;
+}
+
+- (void)tearDown {
+    MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
+    ext.symmetricHelper = self.originalHelper;
+    ext.symmetricKeyCache = self.originalCache;
+}
+
+- (void)testSnapshotNeverChanges {
+    MKFactoryRegistry *registry = [[MKFactoryRegistry alloc] init];
+    MKTestRegistryFactory *aes = [[MKTestRegistryFactory alloc] init];
+    [registry setObject:aes forKey:@"AES"];
+    NSDictionary *snapshot = registry.snapshot;
+    [registry addEntriesFromDictionary:@{
+        @"DES": [[MKTestRegistryFactory alloc] init],
+        @"PLAIN": [[MKTestRegistryFactory alloc] init],
+    }];
+    [registry setObject:nil forKey:@"AES"];
+    XCTAssertEqualObjects(snapshot, @{@"AES": aes});
+    XCTAssertNil([registry objectForKey:@"AES"]);
+    XCTAssertEqual(registry.snapshot.count, 2);
+}
+
+// re-register factories while other threads are looking up
+- (void)testRegisterWhileReading {
+    MKFactoryRegistry<MKTestRegistryFactory *> *registry = [[MKFactoryRegistry alloc] init];
+    [registry setObject:[[MKTestRegistryFactory alloc] init] forKey:@"AES"];
+    dispatch_apply(100000, DISPATCH_APPLY_AUTO, ^(size_t iteration) {
+        @autoreleasepool {
+            if (iteration % 16 == 0) {
+                MKTestRegistryFactory *factory = [[MKTestRegistryFactory alloc] init];
+                factory.version = iteration;
+                [registry setObject:factory forKey:@"AES"];
+                [registry setObject:factory forKey:[NSString stringWithFormat:@"X%zu", iteration % 64]];
+            } else {
+                MKTestRegistryFactory *factory = [registry objectForKey:@"AES"];
+                XCTAssertNotNil(factory);
+                XCTAssertEqual(factory.version % 16, 0);
+            }
+        }
+    });
+    XCTAssertEqual(registry.snapshot.count, 5);
+}
+
+// parse on 'threads' threads while a writer re-registers the factory
+static void parse_while_registering(NSUInteger threads, NSUInteger count) {
+    MKTestRegistryHelper *helper = [[MKTestRegistryHelper alloc] init];
+    [helper setSymmetricKeyFactory:[[MKTestRegistryFactory alloc] init] algorithm:@"AES"];
+    [MKCryptoExtensions sharedInstance].symmetricHelper = helper;
+    NSDictionary *info = @{@"algorithm": @"AES", @"data": @"secret"};
+    __block atomic_bool done = false;
+    dispatch_group_t writer = dispatch_group_create();
+    dispatch_group_async(writer, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        while (!atomic_load(&done)) {
+            @autoreleasepool {
+                [helper setSymmetricKeyFactory:[[MKTestRegistryFactory alloc] init] algorithm:@"AES"];
+            }
+            usleep(100);
+        }
+    });
+    dispatch_apply(threads, DISPATCH_APPLY_AUTO, ^(size_t thread) {
+        for (NSUInteger i = 0; i < count; ++i) {
+            @autoreleasepool {
+                MKSymmetricKeyParse(info);
+            }
+        }
+    });
+    atomic_store(&done, true);
+    dispatch_group_wait(writer, DISPATCH_TIME_FOREVER);
+}
+
+// same work per thread: the same time on all cores means linear scaling
+- (void)testParseThroughputOneThread {
+    [self measureBlock:^{
+        parse_while_registering(1, 100000);
+    }];
+}
+
+- (void)testParseThroughputAllCores {
+    NSUInteger cores = [NSProcessInfo processInfo].activeProcessorCount;
+    [self measureBlock:^{
+        parse_while_registering(cores, 100000);
+    }];
+}
+
+@end
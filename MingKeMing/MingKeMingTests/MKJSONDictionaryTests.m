@@ -0,0 +1,87 @@
+//
+//  MKJSONDictionaryTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Format.h>
+
+@interface MKJSONDictionaryTests : XCTestCase
+
+@end
+
+@implementation MKJSONDictionaryTests
+
+static MKJSONDictionary *parse(NSString *json) {
+    NSData *utf8 = [json dataUsingEncoding:NSUTF8StringEncoding];
+    return [[MKJSONDictionary alloc] initWithJSONData:utf8];
+}
+
+- (void)testLazyFields {
+    MKJSONDictionary *dict = parse(@"{\"ID\": \"moky@anywhere\", \"n\": 1, \"s\\u0041\": [2]}");
+    XCTAssertNotNil(dict);
+    XCTAssertEqualObjects([dict objectForKey:@"ID"], @"moky@anywhere");
+    XCTAssertEqualObjects([dict objectForKey:@"n"], @1);
+    XCTAssertEqualObjects([dict objectForKey:@"sA"], @[@2]);
+    XCTAssertNil([dict objectForKey:@"missing"]);
+    XCTAssertNotNil(dict.JSONData);
+}
+
+- (void)testSyntaxError {
+    XCTAssertNil(parse(@"[1, 2]"));
+    XCTAssertNil(parse(@"{\"a\" 1}"));
+    XCTAssertNil(parse(@"{\"a\": 1"));
+}
+
+- (void)testDuplicatedKeys {
+    MKJSONDictionary *dict = parse(@"{\"a\": 1, \"b\": 2, \"a\": 3}");
+    XCTAssertEqual(dict.count, 2);
+    // the last one wins
+    XCTAssertEqualObjects([dict objectForKey:@"a"], @3);
+    XCTAssertEqual([dict allKeys].count, 2);
+}
+
+- (void)testDictionaryIsInnerMap {
+    MKJSONDictionary *dict = parse(@"{\"a\": 1, \"b\": [2]}");
+    XCTAssertNotNil(dict.JSONData);
+    NSMutableDictionary *inner = dict.dictionary;
+    NSDictionary *expected = @{@"a": @1, @"b": @[@2]};
+    XCTAssertEqualObjects(inner, expected);
+    // taken as a mutation, no copy on next call
+    XCTAssertNil(dict.JSONData);
+    XCTAssertEqual(dict.dictionary, inner);
+    // writes through the inner map are visible
+    [inner setObject:@2 forKey:@"a"];
+    [inner removeObjectForKey:@"b"];
+    XCTAssertEqualObjects([dict objectForKey:@"a"], @2);
+    XCTAssertNil([dict objectForKey:@"b"]);
+    XCTAssertEqual(dict.count, 1);
+}
+
+- (void)testUnpairedSurrogateKey {
+    MKJSONDictionary *dict = parse(@"{\"a\": 1}");
+    unichar chars[] = {0xD800};
+    NSString *bad = [NSString stringWithCharacters:chars length:1];
+    XCTAssertNil([dict objectForKey:bad]);
+}
+
+- (void)testConcurrentReads {
+    NSMutableString *json = [[NSMutableString alloc] initWithString:@"{"];
+    for (NSUInteger i = 0; i < 256; ++i) {
+        [json appendFormat:@"%@\"k%lu\": %lu", i ? @"," : @"", i, i];
+    }
+    [json appendString:@"}"];
+    MKJSONDictionary *dict = parse(json);
+    dispatch_apply(1024, DISPATCH_APPLY_AUTO, ^(size_t iteration) {
+        NSUInteger i = iteration % 256;
+        NSString *key = [NSString stringWithFormat:@"k%lu", i];
+        XCTAssertEqualObjects([dict objectForKey:key], @(i));
+    });
+    XCTAssertEqual(dict.count, 256);
+}
+
+@end
@@ -0,0 +1,244 @@
+//
+//  MKJSONReaderTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Format.h>
+#import <MingKeMing/Ext.h>
+#import <MingKeMing/MingKeMing.h>
+
+// gives some bytes, then fails
+@interface MKTestBrokenStream : NSInputStream
+
+@end
+
+@implementation MKTestBrokenStream {
+    NSData *_head;
+    NSStreamStatus _status;
+}
+
+- (instancetype)initWithData:(NSData *)data {
+    if (self = [super init]) {
+        _head = data;
+        _status = NSStreamStatusNotOpen;
+    }
+    return self;
+}
+
+- (void)open {
+    _status = NSStreamStatusOpen;
+}
+
+- (void)close {
+    _status = NSStreamStatusClosed;
+}
+
+- (NSStreamStatus)streamStatus {
+    return _status;
+}
+
+- (nullable NSError *)streamError {
+    return nil;
+}
+
+- (BOOL)hasBytesAvailable {
+    return YES;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len {
+    return NO;
+}
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len {
+    if (!_head) {
+        _status = NSStreamStatusError;
+        return -1;
+    }
+    NSUInteger cnt = MIN(len, _head.length);
+    memcpy(buffer, _head.bytes, cnt);
+    _head = cnt < _head.length ? [_head subdataWithRange:NSMakeRange(cnt, _head.length - cnt)] : nil;
+    return cnt;
+}
+
+@end
+
+// only parsing, IDs are strings with '@', documents are maps with 'did'
+@interface MKTestReaderHelper : NSObject <MKMIDHelper, MKMDocumentHelper>
+
+@end
+
+@implementation MKTestReaderHelper
+
+- (void)setIDFactory:(id<MKMIDFactory>)factory {
+}
+
+- (nullable id<MKMIDFactory>)getIDFactory {
+    return nil;
+}
+
+- (id<MKMID>)createIDWithAddress:(id<MKMAddress>)address
+                            name:(nullable NSString *)seed
+                        terminal:(nullable NSString *)location {
+    return nil;
+}
+
+- (id<MKMID>)generateIDWithMeta:(id<MKMMeta>)meta
+                           type:(MKMEntityType)network
+                       terminal:(nullable NSString *)location {
+    return nil;
+}
+
+- (nullable id<MKMID>)parseID:(nullable id)identifier {
+    if ([identifier isKindOfClass:[NSString class]] && [identifier containsString:@"@"]) {
+        return (id<MKMID>)[[MKString alloc] initWithString:identifier];
+    }
+    return nil;
+}
+
+- (void)setDocumentFactory:(id<MKMDocumentFactory>)factory forType:(NSString *)type {
+}
+
+- (nullable id<MKMDocumentFactory>)getDocumentFactory:(NSString *)type {
+    return nil;
+}
+
+- (__kindof id<MKMDocument>)createDocumentWithData:(nullable NSString *)json
+                                         signature:(nullable id<MKTransportableData>)sig
+                                           forType:(NSString *)type {
+    return nil;
+}
+
+- (nullable __kindof id<MKMDocument>)parseDocument:(nullable id)doc {
+    if ([doc isKindOfClass:[NSDictionary class]] && [doc objectForKey:@"did"]) {
+        return (id<MKMDocument>)[[MKDictionary alloc] initWithDictionary:doc];
+    }
+    return nil;
+}
+
+@end
+
+@interface MKJSONReaderTests : XCTestCase {
+    id<MKMIDHelper> _idHelper;
+    id<MKMDocumentHelper> _docHelper;
+}
+
+@end
+
+@implementation MKJSONReaderTests
+
+- (void)setUp {
+    MKMAccountExtensions *ext = [MKMAccountExtensions sharedInstance];
+    _idHelper = ext.idHelper;
+    _docHelper = ext.docHelper;
+    MKTestReaderHelper *helper = [[MKTestReaderHelper alloc] init];
+    ext.idHelper = helper;
+    ext.docHelper = helper;
+}
+
+- (void)tearDown {
+    MKMAccountExtensions *ext = [MKMAccountExtensions sharedInstance];
+    ext.idHelper = _idHelper;
+    ext.docHelper = _docHelper;
+}
+
+static NSData *utf8(NSString *json) {
+    return [json dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (void)testReadData {
+    MKJSONArrayReader *reader;
+    reader = [[MKJSONArrayReader alloc] initWithData:utf8(@"[1, \"two\", {\"n\": 3}, [4], true, null]")];
+    NSArray *all = [reader allObjects];
+    NSArray *expected = @[@1, @"two", @{@"n": @3}, @[@4], @YES, [NSNull null]];
+    XCTAssertEqualObjects(all, expected);
+    XCTAssertEqual(reader.count, 6);
+    XCTAssertFalse(reader.isFailed);
+}
+
+- (void)testReadStreamAcrossChunks {
+    NSMutableArray *items = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < 100; ++i) {
+        [items addObject:@{@"ID": [NSString stringWithFormat:@"user%lu@anywhere", i]}];
+    }
+    NSData *json = [NSJSONSerialization dataWithJSONObject:items options:0 error:nil];
+    NSInputStream *stream = [[NSInputStream alloc] initWithData:json];
+    // tiny buffer, so elements span chunks
+    MKJSONArrayReader *reader = [[MKJSONArrayReader alloc] initWithStream:stream bufferSize:7];
+    XCTAssertEqualObjects([reader allObjects], items);
+    XCTAssertFalse(reader.isFailed);
+}
+
+- (void)testEmptyAndBroken {
+    MKJSONArrayReader *reader = [[MKJSONArrayReader alloc] initWithData:utf8(@" [ ] ")];
+    XCTAssertNil([reader nextObject]);
+    XCTAssertFalse(reader.isFailed);
+
+    reader = [[MKJSONArrayReader alloc] initWithData:utf8(@"[1, 2")];
+    [reader allObjects];
+    XCTAssertTrue(reader.isFailed);
+
+    reader = [[MKJSONArrayReader alloc] initWithData:utf8(@"{\"a\": 1}")];
+    XCTAssertNil([reader nextObject]);
+    XCTAssertTrue(reader.isFailed);
+}
+
+- (void)testLeadingZeros {
+    XCTAssertEqualObjects(MKJSONDecodeValue(utf8(@"0")), @0);
+    XCTAssertEqualObjects(MKJSONDecodeValue(utf8(@"-0")), @0);
+    XCTAssertEqualObjects(MKJSONDecodeValue(utf8(@"-120")), @(-120));
+    XCTAssertNil(MKJSONDecodeValue(utf8(@"01")));
+    XCTAssertNil(MKJSONDecodeValue(utf8(@"-007")));
+}
+
+- (void)testScanValue {
+    NSData *data = utf8(@"{\"a\":[1,\"]\"]}, 2");
+    NSUInteger end = MKJSONScanValue(data.bytes, data.length, 0);
+    XCTAssertEqual(end, 13);
+    XCTAssertEqual(MKJSONScanValue(data.bytes, data.length, 15), data.length);
+}
+
+- (void)testStreamReadError {
+    MKTestBrokenStream *stream = [[MKTestBrokenStream alloc] initWithData:utf8(@"[1, 2, ")];
+    MKJSONArrayReader *reader = [[MKJSONArrayReader alloc] initWithStream:stream bufferSize:4];
+    XCTAssertEqualObjects([reader nextObject], @1);
+    XCTAssertEqualObjects([reader nextObject], @2);
+    XCTAssertFalse(reader.isFailed);
+    XCTAssertNil([reader nextObject]);
+    XCTAssertTrue(reader.isFailed);
+    XCTAssertEqual(stream.streamStatus, NSStreamStatusClosed);
+}
+
+- (void)testIDEnumerate {
+    NSData *json = utf8(@"[\"moky@anywhere\", \"invalid\", 3, \"hulk@anywhere\", \"dim@anywhere\"]");
+    MKJSONArrayReader *reader = [[MKJSONArrayReader alloc] initWithData:json];
+    NSMutableArray *found = [[NSMutableArray alloc] init];
+    MKMIDEnumerate(reader, ^(id<MKMID> did, BOOL *stop) {
+        [found addObject:[did string]];
+        // stop after two, the rest stays unread
+        *stop = found.count == 2;
+    });
+    NSArray *expected = @[@"moky@anywhere", @"hulk@anywhere"];
+    XCTAssertEqualObjects(found, expected);
+    XCTAssertEqual(reader.count, 4);
+}
+
+- (void)testDocumentEnumerate {
+    NSData *json = utf8(@"[{\"did\": \"moky@anywhere\"}, {\"name\": \"x\"}, {\"did\": \"hulk@anywhere\"}]");
+    NSInputStream *stream = [[NSInputStream alloc] initWithData:json];
+    MKJSONArrayReader *reader = [[MKJSONArrayReader alloc] initWithStream:stream bufferSize:5];
+    NSMutableArray *found = [[NSMutableArray alloc] init];
+    MKMDocumentEnumerate(reader, ^(id<MKMDocument> doc, BOOL *stop) {
+        [found addObject:[doc objectForKey:@"did"]];
+    });
+    NSArray *expected = @[@"moky@anywhere", @"hulk@anywhere"];
+    XCTAssertEqualObjects(found, expected);
+    XCTAssertFalse(reader.isFailed);
+}
+
+@end
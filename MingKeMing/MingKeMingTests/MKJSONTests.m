@@ -0,0 +1,119 @@
+//
+//  MKJSONTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Format.h>
+
+#import "MKMallocCounter.h"
+
+@interface MKJSONTests : XCTestCase
+
+@end
+
+@implementation MKJSONTests
+
+- (void)testDefaultCoder {
+    id<MKObjectCoder> coder = [MKJSON getCoder];
+    XCTAssertNotNil(coder);
+    XCTAssertTrue([coder respondsToSelector:@selector(encodeData:)]);
+    XCTAssertTrue([coder respondsToSelector:@selector(decodeData:)]);
+}
+
+- (void)testDataRoundTrip {
+    NSDictionary *info = @{@"ID": @"moky@anywhere", @"n": @42, @"list": @[@1, @"二"]};
+    NSData *utf8 = MKJsonEncodeData(info);
+    XCTAssertTrue(utf8.length > 0);
+    XCTAssertEqualObjects(MKJsonDecodeData(utf8), info);
+    XCTAssertEqualObjects(MKJsonDecode(MKJsonEncode(info)), info);
+}
+
+- (void)testDecodeInvalidData {
+    NSData *bad = [@"{\"a\":" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertNil(MKJsonDecodeData(bad));
+}
+
+- (void)testUnwrapBeforeEncoding {
+    MKDictionary *dict = [[MKDictionary alloc] initWithDictionary:@{@"k": @"v"}];
+    NSDictionary *json = MKJsonDecodeData(MKJsonEncodeData(@{@"inner": dict}));
+    XCTAssertEqualObjects(json, @{@"inner": @{@"k": @"v"}});
+}
+
+- (void)testAppendTo {
+    NSMutableData *buffer = [[NSMutableData alloc] initWithBytes:"[" length:1];
+    MKJsonEncodeTo(@{@"a": @1}, buffer);
+    [buffer appendBytes:"," length:1];
+    MKJsonMapEncodeTo(@{@"b": @"x"}, buffer);
+    [buffer appendBytes:"]" length:1];
+    XCTAssertEqualObjects(MKJsonDecodeData(buffer), (@[@{@"a": @1}, @{@"b": @"x"}]));
+    // canonical coder appends in place too
+    MKCanonicalMapCoder *coder = [[MKCanonicalMapCoder alloc] init];
+    [buffer setLength:0];
+    XCTAssertTrue([coder encode:@{@"b": @2, @"a": @1} appendTo:buffer]);
+    XCTAssertEqualObjects([[NSString alloc] initWithData:buffer encoding:NSUTF8StringEncoding],
+                          @"{\"a\":1,\"b\":2}");
+}
+
+- (void)testAppendInvalid {
+    NSMutableData *buffer = [[NSMutableData alloc] initWithBytes:"[" length:1];
+    // reported, not asserted, and nothing written
+    XCTAssertFalse(MKJsonEncodeTo(@{@"n": @(NAN)}, buffer));
+    XCTAssertFalse(MKJsonMapEncodeTo(@{@"d": [NSDate date]}, buffer));
+    XCTAssertEqual(buffer.length, 1);
+    XCTAssertTrue(MKJsonEncodeTo(@[@1], buffer));
+    XCTAssertEqual(buffer.length, 4);
+}
+
+- (void)testAppendWithoutAllocation {
+    NSDictionary *info = @{
+        @"ID": @"moky@anywhere",
+        @"n": @42,
+        @"list": @[@1, @"二", @YES, [NSNull null]],
+        @"map": @{@"k": @"v\n"},
+    };
+    NSMutableData *buffer = [MKJSON threadBuffer];
+    // first call grows the buffer
+    XCTAssertTrue(MKJsonEncodeTo(info, buffer));
+    NSUInteger count = MKCountMallocs(^{
+        for (NSUInteger i = 0; i < 1000; ++i) {
+            [buffer setLength:0];
+            MKJsonEncodeTo(info, buffer);
+        }
+    });
+    // none per message in steady state
+    XCTAssertLessThan(count, 10);
+    XCTAssertEqualObjects(MKJsonDecodeData(buffer), info);
+}
+
+- (void)testThreadBuffer {
+    NSMutableData *buffer = [MKJSON threadBuffer];
+    MKJsonEncodeTo(@{@"k": @"v"}, buffer);
+    XCTAssertTrue(buffer.length > 0);
+    // same buffer, emptied
+    XCTAssertEqual([MKJSON threadBuffer], buffer);
+    XCTAssertEqual(buffer.length, 0);
+    // one for each thread
+    __block NSMutableData *other = nil;
+    NSThread *thread = [[NSThread alloc] initWithBlock:^{
+        other = [MKJSON threadBuffer];
+    }];
+    XCTestExpectation *done = [self expectationWithDescription:@"thread"];
+    [thread start];
+    dispatch_async(dispatch_get_global_queue(0, 0), ^{
+        while (!thread.isFinished) {
+            [NSThread sleepForTimeInterval:0.01];
+        }
+        [done fulfill];
+    });
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertNotNil(other);
+    XCTAssertNotEqual(other, buffer);
+}
+
+@end
@@ -0,0 +1,88 @@
+//
+//  MKLRUCacheTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+
+@interface MKLRUCacheTests : XCTestCase
+
+@property (strong, nonatomic) NSMutableArray<NSString *> *dropped;
+
+@end
+
+@implementation MKLRUCacheTests
+
+- (void)setUp {
+    self.dropped = [[NSMutableArray alloc] init];
+}
+
+- (MKLRUCache<NSString *, NSString *> *)cacheWithLimit:(NSUInteger)limit ttl:(NSTimeInterval)ttl {
+    MKLRUCache *cache = [[MKLRUCache alloc] initWithCountLimit:limit timeToLive:ttl];
+    NSMutableArray *dropped = self.dropped;
+    cache.evictionHandler = ^(NSString *key, NSString *obj) {
+        @synchronized (dropped) {
+            [dropped addObject:[NSString stringWithFormat:@"%@=%@", key, obj]];
+        }
+    };
+    return cache;
+}
+
+- (void)testLeastRecentlyUsedEvicted {
+    MKLRUCache<NSString *, NSString *> *cache = [self cacheWithLimit:2 ttl:0];
+    [cache setObject:@"1" forKey:@"a"];
+    [cache setObject:@"2" forKey:@"b"];
+    XCTAssertEqualObjects([cache objectForKey:@"a"], @"1");
+    [cache setObject:@"3" forKey:@"c"];
+    XCTAssertNil([cache objectForKey:@"b"]);
+    XCTAssertEqualObjects(self.dropped, @[@"b=2"]);
+    XCTAssertEqual(cache.count, 2);
+}
+
+- (void)testReplacedAndRemoved {
+    MKLRUCache<NSString *, NSString *> *cache = [self cacheWithLimit:4 ttl:0];
+    NSString *one = @"1";
+    [cache setObject:one forKey:@"a"];
+    // same object, nothing dropped
+    [cache setObject:one forKey:@"a"];
+    XCTAssertEqual(self.dropped.count, 0);
+    [cache setObject:@"2" forKey:@"a"];
+    [cache setObject:@"3" forKey:@"b"];
+    [cache removeObjectForKey:@"a"];
+    [cache removeObjectForKey:@"x"];
+    XCTAssertEqualObjects(self.dropped, (@[@"a=1", @"a=2"]));
+    [cache removeAllObjects];
+    XCTAssertEqualObjects(self.dropped.lastObject, @"b=3");
+    XCTAssertEqual(cache.count, 0);
+}
+
+- (void)testExpired {
+    MKLRUCache<NSString *, NSString *> *cache = [self cacheWithLimit:4 ttl:0.05];
+    [cache setObject:@"1" forKey:@"a"];
+    XCTAssertEqualObjects([cache objectForKey:@"a"], @"1");
+    [NSThread sleepForTimeInterval:0.1];
+    XCTAssertNil([cache objectForKey:@"a"]);
+    XCTAssertEqualObjects(self.dropped, @[@"a=1"]);
+    XCTAssertEqual(cache.hits, 1);
+    XCTAssertEqual(cache.misses, 1);
+}
+
+- (void)testHandlerMayUseCache {
+    MKLRUCache<NSString *, NSString *> *cache = [[MKLRUCache alloc] initWithCountLimit:1];
+    __weak MKLRUCache *weakCache = cache;
+    __block NSUInteger count = NSNotFound;
+    cache.evictionHandler = ^(NSString *key, NSString *obj) {
+        // called outside the lock
+        count = weakCache.count;
+    };
+    [cache setObject:@"1" forKey:@"a"];
+    [cache setObject:@"2" forKey:@"b"];
+    XCTAssertEqual(count, 1);
+}
+
+@end
@@ -0,0 +1,143 @@
+//
+//  MKMVerifierTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <CommonCrypto/CommonDigest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Digest.h>
+#import <MingKeMing/MingKeMing.h>
+
+@interface MKTestVerifierSHA256 : NSObject <MKMessageDigester>
+
+@end
+
+@implementation MKTestVerifierSHA256
+
+- (NSData *)digest:(NSData *)data {
+    UInt8 md[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, md);
+    return [[NSData alloc] initWithBytes:md length:sizeof(md)];
+}
+
+@end
+
+// only what the engine calls: 'isValid'
+@interface MKTestVerifierMeta : MKDictionary
+
+@property (strong, nonatomic, nullable) dispatch_semaphore_t gate;
+@property (strong, nonatomic) NSMutableArray *calls;
+
+@end
+
+@implementation MKTestVerifierMeta
+
+- (BOOL)isValid {
+    @synchronized (self.calls) {
+        [self.calls addObject:self];
+    }
+    if (self.gate) {
+        dispatch_semaphore_wait(self.gate, DISPATCH_TIME_FOREVER);
+    }
+    return [[self objectForKey:@"valid"] boolValue];
+}
+
+@end
+
+@interface MKMVerifierTests : XCTestCase
+
+@end
+
+@implementation MKMVerifierTests
+
+- (void)setUp {
+    [MKSHA256 setDigester:[[MKTestVerifierSHA256 alloc] init]];
+}
+
+- (void)testIdenticalJobsMerged {
+    MKMVerificationEngine *engine = [MKMVerificationEngine sharedInstance];
+    NSMutableArray *calls = [[NSMutableArray alloc] init];
+    dispatch_semaphore_t gate = dispatch_semaphore_create(0);
+    NSMutableArray *results = [[NSMutableArray alloc] init];
+    XCTestExpectation *done = [self expectationWithDescription:@"verify"];
+    done.expectedFulfillmentCount = 50;
+    for (NSUInteger i = 0; i < 50; ++i) {
+        // equal contents, different instances
+        MKTestVerifierMeta *meta = [[MKTestVerifierMeta alloc] initWithDictionary:@{
+            @"type": @"1", @"seed": @"moky", @"valid": @YES,
+        }];
+        meta.gate = gate;
+        meta.calls = calls;
+        [engine verifyMeta:(id<MKMMeta>)meta completion:^(id<MKMMeta> verified, BOOL valid) {
+            @synchronized (results) {
+                [results addObject:verified];
+            }
+            XCTAssertTrue(valid);
+            [done fulfill];
+        }];
+    }
+    // all submitted while the first one runs
+    dispatch_semaphore_signal(gate);
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertEqual(calls.count, 1);
+    // every caller gets the verified instance
+    for (id verified in results) {
+        XCTAssertEqual(verified, calls.firstObject);
+    }
+}
+
+- (void)testDistinctJobs {
+    MKMVerificationEngine *engine = [MKMVerificationEngine sharedInstance];
+    NSMutableArray *calls = [[NSMutableArray alloc] init];
+    XCTestExpectation *done = [self expectationWithDescription:@"verify"];
+    done.expectedFulfillmentCount = 3;
+    NSArray *infos = @[
+        @{@"seed": @"a", @"valid": @YES},
+        @{@"seed": @"b", @"valid": @NO},
+        // not canonical, verified without merging
+        @{@"seed": @"c", @"valid": @YES, @"bad": @(NAN)},
+    ];
+    for (NSDictionary *info in infos) {
+        MKTestVerifierMeta *meta = [[MKTestVerifierMeta alloc] initWithDictionary:info];
+        meta.calls = calls;
+        [engine verifyMeta:(id<MKMMeta>)meta completion:^(id<MKMMeta> verified, BOOL valid) {
+            XCTAssertEqual(verified, meta);
+            XCTAssertEqual(valid, [[info objectForKey:@"valid"] boolValue]);
+            [done fulfill];
+        }];
+    }
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertEqual(calls.count, 3);
+}
+
+- (void)testNoMergingWithoutDigester {
+    id<MKMessageDigester> digester = [MKSHA256 getDigester];
+    id<MKMessageDigester> none = nil;
+    [MKSHA256 setDigester:none];
+    MKMVerificationEngine *engine = [MKMVerificationEngine sharedInstance];
+    NSMutableArray *calls = [[NSMutableArray alloc] init];
+    XCTestExpectation *done = [self expectationWithDescription:@"verify"];
+    done.expectedFulfillmentCount = 4;
+    for (NSUInteger i = 0; i < 4; ++i) {
+        MKTestVerifierMeta *meta = [[MKTestVerifierMeta alloc] initWithDictionary:@{
+            @"seed": @"moky", @"valid": @YES,
+        }];
+        meta.calls = calls;
+        [engine verifyMeta:(id<MKMMeta>)meta completion:^(id<MKMMeta> verified, BOOL valid) {
+            XCTAssertEqual(verified, meta);
+            XCTAssertTrue(valid);
+            [done fulfill];
+        }];
+    }
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    // each one verified by itself
+    XCTAssertEqual(calls.count, 4);
+    [MKSHA256 setDigester:digester];
+}
+
+@end
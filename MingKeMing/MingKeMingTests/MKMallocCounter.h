@@ -0,0 +1,51 @@
+//
+//  MKMallocCounter.h
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <pthread.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// libmalloc reports every allocation to this hook when it is set
+// (the one MallocStackLogging uses)
+typedef void (MKMallocLogger)(uint32_t type,
+                              uintptr_t arg1, uintptr_t arg2, uintptr_t arg3,
+                              uintptr_t result, uint32_t skip);
+
+extern MKMallocLogger * _Nullable malloc_logger;
+
+#define MKMallocLogTypeAllocate  2  /* malloc, calloc, realloc, ... */
+
+static pthread_t mk_malloc_thread;
+static NSUInteger mk_malloc_count;
+
+static void mk_count_malloc(uint32_t type,
+                            uintptr_t arg1, uintptr_t arg2, uintptr_t arg3,
+                            uintptr_t result, uint32_t skip) {
+    if ((type & MKMallocLogTypeAllocate) && pthread_equal(pthread_self(), mk_malloc_thread)) {
+        ++mk_malloc_count;
+    }
+}
+
+/**
+ *  Count heap allocations made by the block on current thread
+ *
+ * @param block - code to measure
+ * @return number of malloc/calloc/realloc calls
+ */
+static inline NSUInteger MKCountMallocs(void (NS_NOESCAPE ^block)(void)) {
+    MKMallocLogger *previous = malloc_logger;
+    mk_malloc_thread = pthread_self();
+    mk_malloc_count = 0;
+    malloc_logger = mk_count_malloc;
+    block();
+    malloc_logger = previous;
+    return mk_malloc_count;
+}
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,171 @@
+//
+//  MKMatchKeysTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <CommonCrypto/CommonDigest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Digest.h>
+#import <MingKeMing/Crypto.h>
+#import <MingKeMing/Ext.h>
+
+@interface MKTestMatchSHA256 : NSObject <MKMessageDigester>
+
+@end
+
+@implementation MKTestMatchSHA256
+
+- (NSData *)digest:(NSData *)data {
+    UInt8 md[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, md);
+    return [[NSData alloc] initWithBytes:md length:sizeof(md)];
+}
+
+@end
+
+// signature = data + key data, counting verifications
+@interface MKTestMatchKey : MKDictionary <MKSignKey, MKVerifyKey, MKEncryptKey, MKDecryptKey>
+
+@property (strong, nonatomic) NSString *algorithm;
+@property (strong, nonatomic) NSData *data;
+
+@property (nonatomic) NSUInteger verifyCount;
+@property (nonatomic) NSUInteger encryptCount;
+
+@end
+
+@implementation MKTestMatchKey
+
+- (NSData *)sign:(NSData *)data {
+    NSMutableData *signature = [[NSMutableData alloc] initWithData:data];
+    [signature appendData:self.data];
+    return signature;
+}
+
+- (BOOL)verify:(NSData *)data withSignature:(NSData *)signature {
+    _verifyCount += 1;
+    return [[self sign:data] isEqualToData:signature];
+}
+
+- (BOOL)matchSignKey:(id<MKSignKey>)sKey {
+    return MKMatchAsymmetricKeys(sKey, self);
+}
+
+- (NSData *)encrypt:(NSData *)plaintext extra:(nullable NSMutableDictionary *)params {
+    _encryptCount += 1;
+    return [self sign:plaintext];
+}
+
+- (nullable NSData *)decrypt:(NSData *)ciphertext params:(nullable NSDictionary *)extra {
+    NSUInteger len = self.data.length;
+    if (ciphertext.length < len) {
+        return nil;
+    }
+    NSData *tail = [ciphertext subdataWithRange:NSMakeRange(ciphertext.length - len, len)];
+    if (![tail isEqualToData:self.data]) {
+        return nil;
+    }
+    return [ciphertext subdataWithRange:NSMakeRange(0, ciphertext.length - len)];
+}
+
+- (BOOL)matchEncryptKey:(id<MKEncryptKey>)pKey {
+    return MKMatchSymmetricKeys(pKey, self);
+}
+
+- (nullable id<MKCipherStream>)encryptStream:(nullable NSMutableDictionary *)params {
+    return nil;
+}
+
+- (nullable id<MKCipherStream>)decryptStream:(nullable NSDictionary *)extra {
+    return nil;
+}
+
+@end
+
+@interface MKMatchKeysTests : XCTestCase
+
+@end
+
+@implementation MKMatchKeysTests
+
+- (void)setUp {
+    [MKSHA256 setDigester:[[MKTestMatchSHA256 alloc] init]];
+    MKMatchKeysClearCache();
+}
+
+static MKTestMatchKey *new_key(NSString *algorithm, NSString *secret) {
+    MKTestMatchKey *key = [[MKTestMatchKey alloc] init];
+    key.algorithm = algorithm;
+    key.data = [secret dataUsingEncoding:NSUTF8StringEncoding];
+    return key;
+}
+
+- (void)testAsymmetricMemoized {
+    MKTestMatchKey *sKey = new_key(@"TEST", @"secret");
+    MKTestMatchKey *pKey = new_key(@"TEST", @"secret");
+    MKTestMatchKey *other = new_key(@"TEST", @"another");
+    XCTAssertTrue(MKMatchAsymmetricKeys(sKey, pKey));
+    XCTAssertTrue(MKMatchAsymmetricKeys(sKey, pKey));
+    XCTAssertEqual(pKey.verifyCount, 1);
+    XCTAssertFalse(MKMatchAsymmetricKeys(sKey, other));
+    XCTAssertFalse(MKMatchAsymmetricKeys(sKey, other));
+    XCTAssertEqual(other.verifyCount, 1);
+    // forgotten after clearing
+    MKMatchKeysClearCache();
+    XCTAssertTrue(MKMatchAsymmetricKeys(sKey, pKey));
+    XCTAssertEqual(pKey.verifyCount, 2);
+}
+
+- (void)testAsymmetricWithoutDigester {
+    id<MKMessageDigester> digester = [MKSHA256 getDigester];
+    id<MKMessageDigester> none = nil;
+    [MKSHA256 setDigester:none];
+    MKTestMatchKey *sKey = new_key(@"TEST", @"secret");
+    MKTestMatchKey *pKey = new_key(@"TEST", @"secret");
+    XCTAssertTrue(MKMatchAsymmetricKeys(sKey, pKey));
+    XCTAssertTrue(MKMatchAsymmetricKeys(sKey, pKey));
+    // checked every time
+    XCTAssertEqual(pKey.verifyCount, 2);
+    XCTAssertFalse(MKMatchAsymmetricKeys(sKey, new_key(@"TEST", @"another")));
+    [MKSHA256 setDigester:digester];
+}
+
+- (void)testSymmetricSameAlgorithm {
+    MKTestMatchKey *encKey = new_key(@"TEST", @"secret");
+    XCTAssertTrue(MKMatchSymmetricKeys(encKey, new_key(@"TEST", @"secret")));
+    XCTAssertFalse(MKMatchSymmetricKeys(encKey, new_key(@"TEST", @"secreT")));
+    // compared directly, nothing encrypted
+    XCTAssertEqual(encKey.encryptCount, 0);
+}
+
+- (void)testSymmetricMemoized {
+    MKTestMatchKey *encKey = new_key(@"TEST", @"secret");
+    MKTestMatchKey *decKey = new_key(@"OTHER", @"secret");
+    XCTAssertTrue(MKMatchSymmetricKeys(encKey, decKey));
+    XCTAssertTrue(MKMatchSymmetricKeys(encKey, decKey));
+    XCTAssertEqual(encKey.encryptCount, 1);
+    MKMatchKeysClearCache();
+    XCTAssertTrue(MKMatchSymmetricKeys(encKey, decKey));
+    XCTAssertEqual(encKey.encryptCount, 2);
+}
+
+- (void)testSymmetricWithoutDigester {
+    id<MKMessageDigester> digester = [MKSHA256 getDigester];
+    id<MKMessageDigester> none = nil;
+    [MKSHA256 setDigester:none];
+    MKTestMatchKey *encKey = new_key(@"TEST", @"secret");
+    MKTestMatchKey *decKey = new_key(@"OTHER", @"secret");
+    XCTAssertTrue(MKMatchSymmetricKeys(encKey, decKey));
+    XCTAssertTrue(MKMatchSymmetricKeys(encKey, decKey));
+    // checked every time
+    XCTAssertEqual(encKey.encryptCount, 2);
+    XCTAssertFalse(MKMatchSymmetricKeys(encKey, new_key(@"OTHER", @"another")));
+    [MKSHA256 setDigester:digester];
+}
+
+@end
@@ -0,0 +1,167 @@
+//
+//  MKPortableNetworkFileCacheTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <CommonCrypto/CommonDigest.h>
+
+#import <MingKeMing/Digest.h>
+#import <MingKeMing/Format.h>
+
+@interface MKTestCacheSHA256 : NSObject <MKMessageDigester>
+
+@end
+
+@implementation MKTestCacheSHA256
+
+- (NSData *)digest:(NSData *)data {
+    UInt8 md[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, md);
+    return [[NSData alloc] initWithBytes:md length:sizeof(md)];
+}
+
+@end
+
+// Hex coder for digests
+@interface MKTestCacheHex : NSObject <MKDataCoder>
+
+@end
+
+@implementation MKTestCacheHex
+
+- (NSString *)encode:(NSData *)data {
+    const UInt8 *bytes = data.bytes;
+    NSMutableString *hex = [[NSMutableString alloc] initWithCapacity:(data.length * 2)];
+    for (NSUInteger i = 0; i < data.length; ++i) {
+        [hex appendFormat:@"%02x", bytes[i]];
+    }
+    return hex;
+}
+
+- (nullable NSData *)decode:(NSString *)string {
+    return nil;
+}
+
+@end
+
+@interface MKPortableNetworkFileCacheTests : XCTestCase
+
+@property (strong, nonatomic) NSString *directory;
+
+@end
+
+@implementation MKPortableNetworkFileCacheTests
+
+- (void)setUp {
+    [MKHex setCoder:[[MKTestCacheHex alloc] init]];
+    [MKSHA256 setDigester:[[MKTestCacheSHA256 alloc] init]];
+    NSString *name = [NSString stringWithFormat:@"pnf-cache-%@", [NSUUID UUID].UUIDString];
+    self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:name];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.directory error:nil];
+}
+
+static NSData *random_data(NSUInteger length) {
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:length];
+    arc4random_buf(data.mutableBytes, length);
+    return data;
+}
+
+- (NSArray *)namesIn:(NSString *)sub {
+    NSString *path = [self.directory stringByAppendingPathComponent:sub];
+    return [[NSFileManager defaultManager] contentsOfDirectoryAtPath:path error:nil];
+}
+
+- (void)testStoreAndLoad {
+    MKPortableNetworkFileCache *cache;
+    cache = [[MKPortableNetworkFileCache alloc] initWithDirectory:self.directory byteLimit:0];
+    NSData *data = random_data(1000);
+    NSURL *url = [NSURL URLWithString:@"https://cdn.example.com/a.png"];
+    NSString *digest = [cache storeData:data forURL:url];
+    XCTAssertEqual(digest.length, 64);
+    XCTAssertEqualObjects([cache dataForDigest:digest], data);
+    XCTAssertEqualObjects([cache dataForURL:url], data);
+    // same content stored once
+    XCTAssertEqualObjects([cache storeData:data], digest);
+    // no temporary files left
+    XCTAssertEqual([self namesIn:@"blobs"].count, 1);
+    XCTAssertEqual([self namesIn:@"urls"].count, 1);
+    // invalid digests never reach the file system
+    XCTAssertNil([cache dataForDigest:@"../urls"]);
+}
+
+- (void)testZeroLimitIsUnlimited {
+    MKPortableNetworkFileCache *cache;
+    cache = [[MKPortableNetworkFileCache alloc] initWithDirectory:self.directory byteLimit:0];
+    for (NSUInteger i = 0; i < 16; ++i) {
+        XCTAssertNotNil([cache storeData:random_data(4096)]);
+    }
+    [cache trim];
+    XCTAssertEqual([self namesIn:@"blobs"].count, 16);
+}
+
+- (void)testEvictionDropsURLs {
+    MKPortableNetworkFileCache *cache;
+    cache = [[MKPortableNetworkFileCache alloc] initWithDirectory:self.directory byteLimit:(64 * 1024)];
+    NSURL *first = [NSURL URLWithString:@"https://cdn.example.com/0"];
+    NSString *digest = [cache storeData:random_data(32 * 1024) forURL:first];
+    // make it the least recently used
+    NSString *path = [[self.directory stringByAppendingPathComponent:@"blobs"] stringByAppendingPathComponent:digest];
+    [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate: [NSDate distantPast]}
+                                     ofItemAtPath:path
+                                            error:nil];
+    for (NSUInteger i = 1; i < 4; ++i) {
+        NSURL *url = [NSURL URLWithString:[NSString stringWithFormat:@"https://cdn.example.com/%lu", i]];
+        [cache storeData:random_data(20 * 1024) forURL:url];
+    }
+    [cache trim];
+    XCTAssertNil([cache dataForDigest:digest]);
+    XCTAssertNil([cache dataForURL:first]);
+    // one entry per cached blob
+    XCTAssertEqual([self namesIn:@"urls"].count, [self namesIn:@"blobs"].count);
+}
+
+- (void)testTrimRemovesStaleTemps {
+    MKPortableNetworkFileCache *cache;
+    cache = [[MKPortableNetworkFileCache alloc] initWithDirectory:self.directory byteLimit:0];
+    NSString *digest = [cache storeData:random_data(4096)];
+    NSFileManager *fm = [NSFileManager defaultManager];
+    // left by crashed writers: '<digest>.<pid>.<uuid>.tmp'
+    NSMutableArray *fresh = [[NSMutableArray alloc] init];
+    for (NSString *sub in @[@"blobs", @"urls"]) {
+        NSString *dir = [self.directory stringByAppendingPathComponent:sub];
+        NSString *name = [NSString stringWithFormat:@"%@.%d.%@.tmp", digest, 12345, [NSUUID UUID].UUIDString];
+        NSString *stale = [dir stringByAppendingPathComponent:name];
+        [random_data(1024) writeToFile:stale atomically:NO];
+        [fm setAttributes:@{NSFileModificationDate: [NSDate dateWithTimeIntervalSinceNow:-7200]}
+             ofItemAtPath:stale
+                    error:nil];
+        // still being written
+        name = [NSString stringWithFormat:@"%@.%d.%@.tmp", digest, 12345, [NSUUID UUID].UUIDString];
+        [random_data(1024) writeToFile:[dir stringByAppendingPathComponent:name] atomically:NO];
+        [fresh addObject:name];
+    }
+    [cache trim];
+    NSArray *blobs = [[self namesIn:@"blobs"] sortedArrayUsingSelector:@selector(compare:)];
+    XCTAssertEqualObjects(blobs, ([@[digest, fresh[0]] sortedArrayUsingSelector:@selector(compare:)]));
+    XCTAssertEqualObjects([self namesIn:@"urls"], @[fresh[1]]);
+    XCTAssertNotNil([cache dataForDigest:digest]);
+}
+
+- (void)testLookupDropsStaleURL {
+    MKPortableNetworkFileCache *cache;
+    cache = [[MKPortableNetworkFileCache alloc] initWithDirectory:self.directory byteLimit:0];
+    NSURL *url = [NSURL URLWithString:@"https://cdn.example.com/b.png"];
+    NSString *digest = [cache storeData:random_data(100) forURL:url];
+    [cache removeDataForDigest:digest];
+    XCTAssertNil([cache dataForURL:url]);
+    XCTAssertEqual([self namesIn:@"urls"].count, 0);
+}
+
+@end
@@ -0,0 +1,293 @@
+//
+//  MKPortableNetworkFileStreamTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Format.h>
+#import <MingKeMing/Crypto.h>
+
+// Base-64 coder for params
+@interface MKTestStreamBase64 : NSObject <MKDataCoder>
+
+@end
+
+@implementation MKTestStreamBase64
+
+- (NSString *)encode:(NSData *)data {
+    return [data base64EncodedStringWithOptions:0];
+}
+
+- (nullable NSData *)decode:(NSString *)string {
+    return [[NSData alloc] initWithBase64EncodedString:string options:0];
+}
+
+@end
+
+// AES key with stream support
+@interface MKTestStreamKey : MKDictionary <MKEncryptKey, MKDecryptKey>
+
+@property (strong, nonatomic) NSData *data;
+
+@end
+
+@implementation MKTestStreamKey
+
+- (NSString *)algorithm {
+    return @"AES";
+}
+
+- (NSData *)encrypt:(NSData *)plaintext extra:(nullable NSMutableDictionary *)params {
+    id<MKCipherStream> cipher = [self encryptStream:params];
+    NSMutableData *out = [[NSMutableData alloc] initWithData:[cipher update:plaintext]];
+    [out appendData:[cipher finish]];
+    return out;
+}
+
+- (nullable NSData *)decrypt:(NSData *)ciphertext params:(nullable NSDictionary *)extra {
+    id<MKCipherStream> cipher = [self decryptStream:extra];
+    NSMutableData *out = [[NSMutableData alloc] initWithData:[cipher update:ciphertext]];
+    NSData *last = [cipher finish];
+    if (!last) {
+        return nil;
+    }
+    [out appendData:last];
+    return out;
+}
+
+- (BOOL)matchEncryptKey:(id<MKEncryptKey>)pKey {
+    return [pKey.data isEqualToData:self.data];
+}
+
+- (nullable id<MKCipherStream>)encryptStream:(nullable NSMutableDictionary *)params {
+    return [MKAESStream encryptStreamWithKey:self.data params:params];
+}
+
+- (nullable id<MKCipherStream>)decryptStream:(nullable NSDictionary *)extra {
+    return [MKAESStream decryptStreamWithKey:self.data params:(extra ? extra : @{})];
+}
+
+@end
+
+// AES key without stream support
+@interface MKTestBlockKey : MKTestStreamKey
+
+@end
+
+@implementation MKTestBlockKey
+
+- (BOOL)respondsToSelector:(SEL)aSelector {
+    if (aSelector == @selector(encryptStream:) || aSelector == @selector(decryptStream:)) {
+        return NO;
+    }
+    return [super respondsToSelector:aSelector];
+}
+
+@end
+
+// PNF with a remote URL only
+@interface MKTestRemoteFile : MKDictionary <MKPortableNetworkFile>
+
+@property (strong, nonatomic, nullable) NSData *data;
+@property (strong, nonatomic, nullable) NSString *filename;
+@property (strong, nonatomic, nullable) NSURL *URL;
+@property (strong, nonatomic, nullable) __kindof id<MKDecryptKey> password;
+
+@end
+
+@implementation MKTestRemoteFile
+
+- (NSString *)string {
+    return self.URL.absoluteString;
+}
+
+- (NSObject *)object {
+    return [self dictionary];
+}
+
+@end
+
+@interface MKPortableNetworkFileStreamTests : XCTestCase
+
+@property (strong, nonatomic) NSURL *directory;
+
+@end
+
+@implementation MKPortableNetworkFileStreamTests
+
+- (void)setUp {
+    [MKBase64 setCoder:[[MKTestStreamBase64 alloc] init]];
+    NSString *name = [NSString stringWithFormat:@"pnf-%@", [NSUUID UUID].UUIDString];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:name];
+    [[NSFileManager defaultManager] createDirectoryAtPath:path
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:nil];
+    self.directory = [NSURL fileURLWithPath:path];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.directory error:nil];
+}
+
+static MKTestStreamKey *new_key(void) {
+    MKTestStreamKey *key = [[MKTestStreamKey alloc] init];
+    NSMutableData *pwd = [[NSMutableData alloc] initWithLength:32];
+    arc4random_buf(pwd.mutableBytes, pwd.length);
+    key.data = pwd;
+    return key;
+}
+
+// encrypt random content into a file, returns plaintext
+- (NSData *)encryptWithKey:(MKTestStreamKey *)key
+                    params:(NSMutableDictionary *)params
+                    toFile:(NSURL *)url {
+    NSMutableData *plaintext = [[NSMutableData alloc] initWithLength:(1024 * 1024 + 17)];
+    arc4random_buf(plaintext.mutableBytes, plaintext.length);
+    NSData *ciphertext = [key encrypt:plaintext extra:params];
+    [ciphertext writeToURL:url atomically:YES];
+    return plaintext;
+}
+
+- (void)testDecryptWithPNFParams {
+    MKTestStreamKey *key = new_key();
+    NSMutableDictionary *params = [[NSMutableDictionary alloc] init];
+    NSURL *source = [self.directory URLByAppendingPathComponent:@"download"];
+    NSURL *destination = [self.directory URLByAppendingPathComponent:@"plain"];
+    NSData *plaintext = [self encryptWithKey:key params:params toFile:source];
+    XCTAssertNotNil([params objectForKey:@"IV"]);
+    XCTAssertNotNil([params objectForKey:@"tag"]);
+
+    MKTestRemoteFile *pnf = [[MKTestRemoteFile alloc] init];
+    pnf.URL = [NSURL URLWithString:@"https://cdn.example.com/file"];
+    pnf.password = key;
+    [pnf setObject:[params objectForKey:@"IV"] forKey:@"IV"];
+    [pnf setObject:[params objectForKey:@"tag"] forKey:@"tag"];
+
+    XCTestExpectation *done = [self expectationWithDescription:@"decrypt"];
+    MKPortableNetworkFileDecrypt(pnf, source, destination, ^(NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects([NSData dataWithContentsOfURL:destination], plaintext);
+        [done fulfill];
+    });
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+- (void)testTamperedFileNotCommitted {
+    MKTestStreamKey *key = new_key();
+    NSMutableDictionary *params = [[NSMutableDictionary alloc] init];
+    NSURL *source = [self.directory URLByAppendingPathComponent:@"download"];
+    NSURL *destination = [self.directory URLByAppendingPathComponent:@"plain"];
+    [self encryptWithKey:key params:params toFile:source];
+    // flip one byte
+    NSMutableData *bad = [[NSMutableData alloc] initWithContentsOfURL:source];
+    ((UInt8 *)bad.mutableBytes)[100] ^= 0x01;
+    [bad writeToURL:source atomically:YES];
+
+    MKPortableNetworkFileDecrypter *decrypter;
+    decrypter = [[MKPortableNetworkFileDecrypter alloc] initWithPassword:key params:params];
+    decrypter.chunkSize = 4096;
+    XCTestExpectation *done = [self expectationWithDescription:@"decrypt"];
+    [decrypter decryptFile:source toFile:destination completion:^(NSError *error) {
+        XCTAssertEqual(error.code, MKPortableNetworkFileErrorDecrypt);
+        // nothing left behind
+        NSArray *names = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:self.directory.path
+                                                                             error:nil];
+        XCTAssertEqualObjects(names, @[@"download"]);
+        [done fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+- (void)testEncryptRoundTrip {
+    MKTestStreamKey *key = new_key();
+    NSURL *source = [self.directory URLByAppendingPathComponent:@"photo"];
+    NSURL *upload = [self.directory URLByAppendingPathComponent:@"upload"];
+    NSURL *destination = [self.directory URLByAppendingPathComponent:@"plain"];
+    NSMutableData *plaintext = [[NSMutableData alloc] initWithLength:(1024 * 1024 + 17)];
+    arc4random_buf(plaintext.mutableBytes, plaintext.length);
+    [plaintext writeToURL:source atomically:YES];
+
+    MKTestRemoteFile *pnf = [[MKTestRemoteFile alloc] init];
+    pnf.URL = [NSURL URLWithString:@"https://cdn.example.com/file"];
+    pnf.password = key;
+
+    XCTestExpectation *encrypted = [self expectationWithDescription:@"encrypt"];
+    MKPortableNetworkFileEncrypt(pnf, source, upload, ^(NSError *error) {
+        XCTAssertNil(error);
+        [encrypted fulfill];
+    });
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    XCTAssertNotNil([pnf objectForKey:@"IV"]);
+    XCTAssertNotNil([pnf objectForKey:@"tag"]);
+    NSData *ciphertext = [NSData dataWithContentsOfURL:upload];
+    XCTAssertEqual(ciphertext.length, plaintext.length);
+    XCTAssertNotEqualObjects(ciphertext, plaintext);
+
+    XCTestExpectation *decrypted = [self expectationWithDescription:@"decrypt"];
+    MKPortableNetworkFileDecrypt(pnf, upload, destination, ^(NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects([NSData dataWithContentsOfURL:destination], plaintext);
+        [decrypted fulfill];
+    });
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+- (void)testEncryptToStream {
+    MKTestStreamKey *key = new_key();
+    NSURL *source = [self.directory URLByAppendingPathComponent:@"photo"];
+    NSMutableData *plaintext = [[NSMutableData alloc] initWithLength:(100 * 1024 + 3)];
+    arc4random_buf(plaintext.mutableBytes, plaintext.length);
+    [plaintext writeToURL:source atomically:YES];
+
+    MKPortableNetworkFileEncrypter *encrypter;
+    encrypter = [[MKPortableNetworkFileEncrypter alloc] initWithPassword:key];
+    encrypter.chunkSize = 4096;
+    NSOutputStream *sink = [[NSOutputStream alloc] initToMemory];
+    XCTestExpectation *done = [self expectationWithDescription:@"encrypt"];
+    [encrypter encryptFile:source toStream:sink completion:^(NSDictionary *params, NSError *error) {
+        XCTAssertNil(error);
+        NSData *ciphertext = [sink propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+        XCTAssertEqualObjects([key decrypt:ciphertext params:params], plaintext);
+        [done fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+- (void)testWholeFileLimit {
+    MKTestBlockKey *key = [[MKTestBlockKey alloc] init];
+    key.data = new_key().data;
+    NSMutableDictionary *params = [[NSMutableDictionary alloc] init];
+    NSURL *source = [self.directory URLByAppendingPathComponent:@"download"];
+    NSURL *destination = [self.directory URLByAppendingPathComponent:@"plain"];
+    NSData *plaintext = [self encryptWithKey:key params:params toFile:source];
+
+    MKPortableNetworkFileDecrypter *decrypter;
+    decrypter = [[MKPortableNetworkFileDecrypter alloc] initWithPassword:key params:params];
+    // too big to load at once
+    decrypter.wholeFileLimit = 1024;
+    XCTestExpectation *rejected = [self expectationWithDescription:@"rejected"];
+    [decrypter decryptFile:source toFile:destination completion:^(NSError *error) {
+        XCTAssertEqual(error.code, MKPortableNetworkFileErrorUnsupported);
+        [rejected fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:destination.path]);
+
+    // small enough
+    decrypter.wholeFileLimit = plaintext.length;
+    XCTestExpectation *done = [self expectationWithDescription:@"decrypt"];
+    [decrypter decryptFile:source toFile:destination completion:^(NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects([NSData dataWithContentsOfURL:destination], plaintext);
+        [done fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+@end
@@ -0,0 +1,104 @@
+//
+//  MKPortableNetworkFileTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Format.h>
+#import <MingKeMing/Crypto.h>
+
+@interface MKTestFileBase64 : NSObject <MKDataCoder>
+
+@end
+
+@implementation MKTestFileBase64
+
+- (NSString *)encode:(NSData *)data {
+    return [data base64EncodedStringWithOptions:0];
+}
+
+- (nullable NSData *)decode:(NSString *)string {
+    return [[NSData alloc] initWithBase64EncodedString:string options:0];
+}
+
+@end
+
+// PNF keeping its file data out of the inner dictionary
+@interface MKTestLocalFile : MKDictionary <MKPortableNetworkFile>
+
+@property (strong, nonatomic, nullable) NSData *data;
+@property (strong, nonatomic, nullable) NSURL *URL;
+@property (strong, nonatomic, nullable) __kindof id<MKDecryptKey> password;
+
+@end
+
+@implementation MKTestLocalFile
+
+- (nullable NSString *)filename {
+    return [self stringForKey:@"filename" defaultValue:nil];
+}
+
+- (void)setFilename:(nullable NSString *)filename {
+    [self setObject:filename forKey:@"filename"];
+}
+
+- (NSString *)string {
+    return MKJsonMapEncode([self dictionary]);
+}
+
+- (NSObject *)object {
+    return [self dictionary];
+}
+
+@end
+
+@interface MKPortableNetworkFileTests : XCTestCase
+
+@end
+
+@implementation MKPortableNetworkFileTests
+
+- (void)setUp {
+    [MKBase64 setCoder:[[MKTestFileBase64 alloc] init]];
+}
+
+static NSDictionary *write_to_memory(id<MKPortableNetworkFile> pnf) {
+    NSOutputStream *sink = [NSOutputStream outputStreamToMemory];
+    [sink open];
+    BOOL ok = MKPortableNetworkFileWrite(pnf, sink);
+    NSData *out = [sink propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+    [sink close];
+    return ok ? [NSJSONSerialization JSONObjectWithData:out options:0 error:nil] : nil;
+}
+
+- (void)testStreamingWrite {
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:(200 * 1024 + 1)];
+    arc4random_buf(data.mutableBytes, data.length);
+    MKTestLocalFile *pnf = [[MKTestLocalFile alloc] init];
+    pnf.filename = @"photo \"1\".jpg";
+    pnf.data = data;
+    NSDictionary *info = write_to_memory(pnf);
+    XCTAssertEqualObjects([info objectForKey:@"filename"], @"photo \"1\".jpg");
+    NSData *decoded = [[NSData alloc] initWithBase64EncodedString:[info objectForKey:@"data"]
+                                                          options:0];
+    XCTAssertEqualObjects(decoded, data);
+    // nothing encoded into the PNF itself
+    XCTAssertNil([pnf objectForKey:@"data"]);
+}
+
+- (void)testWriteWithoutData {
+    MKTestLocalFile *pnf = [[MKTestLocalFile alloc] init];
+    [pnf setObject:@"https://cdn.example.com/a.png" forKey:@"URL"];
+    XCTAssertEqualObjects(write_to_memory(pnf), @{@"URL": @"https://cdn.example.com/a.png"});
+
+    pnf = [[MKTestLocalFile alloc] init];
+    pnf.data = [@"hello" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertEqualObjects(write_to_memory(pnf), @{@"data": @"aGVsbG8="});
+}
+
+@end
@@ -0,0 +1,163 @@
+//
+//  MKPrivateKeyCacheTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <CommonCrypto/CommonDigest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Digest.h>
+#import <MingKeMing/Crypto.h>
+#import <MingKeMing/Ext.h>
+
+@interface MKTestKeyCacheSHA256 : NSObject <MKMessageDigester>
+
+@end
+
+@implementation MKTestKeyCacheSHA256
+
+- (NSData *)digest:(NSData *)data {
+    UInt8 md[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, md);
+    return [[NSData alloc] initWithBytes:md length:sizeof(md)];
+}
+
+@end
+
+@interface MKTestCachedKey : MKDictionary <MKPrivateKey, MKPublicKey>
+
+@property (strong, nonatomic) NSData *data;
+@property (strong, nonatomic) id<MKPublicKey> publicKey;
+
+@end
+
+@implementation MKTestCachedKey
+
+- (NSString *)algorithm {
+    return [self stringForKey:@"algorithm" defaultValue:@""];
+}
+
+- (NSData *)sign:(NSData *)data {
+    return data;
+}
+
+- (BOOL)verify:(NSData *)data withSignature:(NSData *)signature {
+    return [data isEqualToData:signature];
+}
+
+- (BOOL)matchSignKey:(id<MKSignKey>)sKey {
+    return MKMatchAsymmetricKeys(sKey, self);
+}
+
+@end
+
+// key data from "secret"
+@interface MKTestKeyCacheHelper : NSObject <MKPrivateKeyHelper, MKPublicKeyHelper>
+
+@property (nonatomic) NSUInteger parseCount;
+
+@end
+
+@implementation MKTestKeyCacheHelper
+
+- (void)setPrivateKeyFactory:(id<MKPrivateKeyFactory>)factory algorithm:(NSString *)name {
+}
+
+- (nullable id<MKPrivateKeyFactory>)getPrivateKeyFactory:(NSString *)algorithm {
+    return nil;
+}
+
+- (nullable id<MKPrivateKey>)generatePrivateKey:(NSString *)algorithm {
+    return nil;
+}
+
+- (nullable id<MKPrivateKey>)parsePrivateKey:(nullable id)key {
+    _parseCount += 1;
+    MKTestCachedKey *sKey = [[MKTestCachedKey alloc] initWithDictionary:key];
+    sKey.data = [[key objectForKey:@"secret"] dataUsingEncoding:NSUTF8StringEncoding];
+    return sKey;
+}
+
+- (void)setPublicKeyFactory:(id<MKPublicKeyFactory>)factory algorithm:(NSString *)name {
+}
+
+- (nullable id<MKPublicKeyFactory>)getPublicKeyFactory:(NSString *)algorithm {
+    return nil;
+}
+
+- (nullable id<MKPublicKey>)parsePublicKey:(nullable id)key {
+    _parseCount += 1;
+    MKTestCachedKey *pKey = [[MKTestCachedKey alloc] initWithDictionary:key];
+    pKey.data = [[key objectForKey:@"secret"] dataUsingEncoding:NSUTF8StringEncoding];
+    return pKey;
+}
+
+@end
+
+@interface MKPrivateKeyCacheTests : XCTestCase
+
+@property (strong, nonatomic) MKTestKeyCacheHelper *helper;
+
+@property (strong, nonatomic, nullable) id<MKPrivateKeyHelper> originalPrivateHelper;
+@property (strong, nonatomic, nullable) id<MKPublicKeyHelper> originalPublicHelper;
+@property (strong, nonatomic, nullable) MKLRUCache *originalCache;
+
+@end
+
+@implementation MKPrivateKeyCacheTests
+
+- (void)setUp {
+    [MKSHA256 setDigester:[[MKTestKeyCacheSHA256 alloc] init]];
+    MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
+    self.originalPrivateHelper = ext.privateHelper;
+    self.originalPublicHelper = ext.publicHelper;
+    self.originalCache = ext.publicKeyCache;
+    self.helper = [[MKTestKeyCacheHelper alloc] init];
+    ext.privateHelper = self.helper;
+    ext.publicHelper = self.helper;
+    ext.publicKeyCache = [[MKLRUCache alloc] initWithCountLimit:16];
+}
+
+- (void)tearDown {
+    MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
+    ext.privateHelper = self.originalPrivateHelper;
+    ext.publicHelper = self.originalPublicHelper;
+    ext.publicKeyCache = self.originalCache;
+    [MKSHA256 setDigester:[[MKTestKeyCacheSHA256 alloc] init]];
+}
+
+- (void)testPrivateKeyNotCached {
+    NSDictionary *info = @{@"algorithm": @"TEST", @"secret": @"secret"};
+    id<MKPrivateKey> key1 = MKPrivateKeyParse(info);
+    id<MKPrivateKey> key2 = MKPrivateKeyParse(info);
+    XCTAssertNotNil(key1);
+    // each caller owns its key
+    XCTAssertNotEqual(key1, key2);
+    XCTAssertEqual(self.helper.parseCount, 2);
+    XCTAssertEqual([MKCryptoExtensions sharedInstance].publicKeyCache.count, 0);
+}
+
+- (void)testPublicKeyCached {
+    NSDictionary *info = @{@"algorithm": @"TEST", @"secret": @"public"};
+    id<MKPublicKey> key = MKPublicKeyParse(info);
+    XCTAssertNotNil(key);
+    XCTAssertEqual(MKPublicKeyParse([info mutableCopy]), key);
+    XCTAssertEqual(self.helper.parseCount, 1);
+}
+
+- (void)testNotCachedWithoutDigester {
+    id<MKMessageDigester> none = nil;
+    [MKSHA256 setDigester:none];
+    NSDictionary *info = @{@"algorithm": @"TEST", @"secret": @"public"};
+    XCTAssertNil(MKCryptoKeyCacheKey(info));
+    XCTAssertNotNil(MKPublicKeyParse(info));
+    XCTAssertNotNil(MKPublicKeyParse(info));
+    XCTAssertEqual(self.helper.parseCount, 2);
+}
+
+@end
@@ -0,0 +1,123 @@
+//
+//  MKPrivateKeyPoolTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Crypto.h>
+#import <MingKeMing/Ext.h>
+
+@interface MKTestPoolKey : MKDictionary <MKPrivateKey>
+
+@property (strong, nonatomic) NSString *algorithm;
+@property (strong, nonatomic) NSData *data;
+@property (strong, nonatomic) id<MKPublicKey> publicKey;
+
+@end
+
+@implementation MKTestPoolKey
+
+- (NSData *)sign:(NSData *)data {
+    return data;
+}
+
+@end
+
+// generates keys for "TEST" only
+@interface MKTestPoolHelper : NSObject <MKPrivateKeyHelper>
+
+@end
+
+@implementation MKTestPoolHelper
+
+- (void)setPrivateKeyFactory:(id<MKPrivateKeyFactory>)factory algorithm:(NSString *)name {
+}
+
+- (nullable id<MKPrivateKeyFactory>)getPrivateKeyFactory:(NSString *)algorithm {
+    return nil;
+}
+
+- (nullable id<MKPrivateKey>)generatePrivateKey:(NSString *)algorithm {
+    if (![algorithm isEqualToString:@"TEST"]) {
+        return nil;
+    }
+    MKTestPoolKey *key = [[MKTestPoolKey alloc] init];
+    key.algorithm = algorithm;
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:32];
+    arc4random_buf(data.mutableBytes, data.length);
+    key.data = data;
+    return key;
+}
+
+- (nullable id<MKPrivateKey>)parsePrivateKey:(nullable id)key {
+    return nil;
+}
+
+@end
+
+@interface MKPrivateKeyPoolTests : XCTestCase
+
+@property (strong, nonatomic, nullable) id<MKPrivateKeyHelper> originalHelper;
+
+@end
+
+@implementation MKPrivateKeyPoolTests
+
+- (void)setUp {
+    MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
+    self.originalHelper = ext.privateHelper;
+    ext.privateHelper = [[MKTestPoolHelper alloc] init];
+}
+
+- (void)tearDown {
+    [MKCryptoExtensions sharedInstance].privateHelper = self.originalHelper;
+}
+
+// poll until condition or timeout
+static BOOL wait_until(BOOL (^condition)(void)) {
+    for (NSUInteger i = 0; i < 500; ++i) {
+        if (condition()) {
+            return YES;
+        }
+        [NSThread sleepForTimeInterval:0.01];
+    }
+    return condition();
+}
+
+- (void)testFillAndTake {
+    MKPrivateKeyPool *pool = [[MKPrivateKeyPool alloc] init];
+    [pool setWatermark:4 forAlgorithm:@"TEST"];
+    XCTAssertTrue(wait_until(^BOOL{
+        return [pool depthForAlgorithm:@"TEST"] == 4;
+    }));
+    XCTAssertNotNil([pool takeKey:@"TEST"]);
+    XCTAssertEqual(pool.hits, 1);
+    // refilled in background
+    XCTAssertTrue(wait_until(^BOOL{
+        return [pool depthForAlgorithm:@"TEST"] == 4;
+    }));
+    XCTAssertEqual(pool.failures, 0);
+}
+
+- (void)testUnsupportedAlgorithmSurfaced {
+    MKPrivateKeyPool *pool = [[MKPrivateKeyPool alloc] init];
+    [pool setWatermark:4 forAlgorithm:@"NONE"];
+    XCTAssertTrue(wait_until(^BOOL{
+        return pool.failures == 1;
+    }));
+    XCTAssertEqual([pool depthForAlgorithm:@"NONE"], 0);
+    XCTAssertNil([pool takeKey:@"NONE"]);
+    XCTAssertEqual(pool.misses, 1);
+    // tried again on demand, not in a loop
+    XCTAssertTrue(wait_until(^BOOL{
+        return pool.failures == 2;
+    }));
+    XCTAssertEqual(pool.generated, 0);
+}
+
+@end
@@ -0,0 +1,171 @@
+//
+//  MKSessionKeyCacheTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <CommonCrypto/CommonDigest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Digest.h>
+#import <MingKeMing/Crypto.h>
+#import <MingKeMing/Ext.h>
+
+@interface MKTestSessionSHA256 : NSObject <MKMessageDigester>
+
+@end
+
+@implementation MKTestSessionSHA256
+
+- (NSData *)digest:(NSData *)data {
+    UInt8 md[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, md);
+    return [[NSData alloc] initWithBytes:md length:sizeof(md)];
+}
+
+@end
+
+// session key keeping its prepared state across copies
+@interface MKTestSessionKey : MKDictionary <MKSymmetricKey>
+
+@property (strong, nonatomic, nullable) NSObject *prepared;
+
+@end
+
+@implementation MKTestSessionKey
+
+- (id)copyWithZone:(nullable NSZone *)zone {
+    MKTestSessionKey *key = [super copyWithZone:zone];
+    key.prepared = self.prepared;
+    return key;
+}
+
+- (NSString *)algorithm {
+    return [self stringForKey:@"algorithm" defaultValue:@""];
+}
+
+- (NSData *)data {
+    return [[self stringForKey:@"data" defaultValue:@""] dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (void)prepare {
+    self.prepared = [[NSObject alloc] init];
+}
+
+- (NSData *)encrypt:(NSData *)plaintext extra:(nullable NSMutableDictionary *)params {
+    return plaintext;
+}
+
+- (nullable NSData *)decrypt:(NSData *)ciphertext params:(nullable NSDictionary *)extra {
+    return ciphertext;
+}
+
+- (BOOL)matchEncryptKey:(id<MKEncryptKey>)pKey {
+    return [pKey.data isEqualToData:self.data];
+}
+
+- (nullable id<MKCipherStream>)encryptStream:(nullable NSMutableDictionary *)params {
+    return nil;
+}
+
+- (nullable id<MKCipherStream>)decryptStream:(nullable NSDictionary *)extra {
+    return nil;
+}
+
+@end
+
+@interface MKTestSessionHelper : NSObject <MKSymmetricKeyHelper>
+
+@property (nonatomic) NSUInteger parseCount;
+
+@end
+
+@implementation MKTestSessionHelper
+
+- (void)setSymmetricKeyFactory:(id<MKSymmetricKeyFactory>)factory algorithm:(NSString *)name {
+}
+
+- (nullable id<MKSymmetricKeyFactory>)getSymmetricKeyFactory:(NSString *)algorithm {
+    return nil;
+}
+
+- (nullable id<MKSymmetricKey>)generateSymmetricKey:(NSString *)algorithm {
+    return nil;
+}
+
+- (nullable id<MKSymmetricKey>)parseSymmetricKey:(nullable id)key {
+    _parseCount += 1;
+    if (![key objectForKey:@"algorithm"]) {
+        return nil;
+    }
+    return [[MKTestSessionKey alloc] initWithDictionary:key];
+}
+
+@end
+
+@interface MKSessionKeyCacheTests : XCTestCase
+
+@property (strong, nonatomic) MKTestSessionHelper *helper;
+
+@property (strong, nonatomic, nullable) id<MKSymmetricKeyHelper> originalHelper;
+@property (strong, nonatomic, nullable) MKLRUCache *originalCache;
+
+@end
+
+@implementation MKSessionKeyCacheTests
+
+- (void)setUp {
+    [MKSHA256 setDigester:[[MKTestSessionSHA256 alloc] init]];
+    MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
+    self.originalHelper = ext.symmetricHelper;
+    self.originalCache = ext.symmetricKeyCache;
+    self.helper = [[MKTestSessionHelper alloc] init];
+    ext.symmetricHelper = self.helper;
+    ext.symmetricKeyCache = [[MKLRUCache alloc] initWithCountLimit:8 timeToLive:60];
+}
+
+- (void)tearDown {
+    MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
+    ext.symmetricHelper = self.originalHelper;
+    ext.symmetricKeyCache = self.originalCache;
+}
+
+- (void)testEachParseGetsCopy {
+    NSDictionary *info = @{@"algorithm": @"AES", @"data": @"secret"};
+    MKTestSessionKey *key1 = MKSymmetricKeyParse(info);
+    MKTestSessionKey *key2 = MKSymmetricKeyParse(info);
+    XCTAssertEqual(self.helper.parseCount, 1);
+    XCTAssertNotEqual(key1, key2);
+    // prepared once, shared by copies
+    XCTAssertNotNil(key1.prepared);
+    XCTAssertEqual(key1.prepared, key2.prepared);
+    // modifying one does not leak into the cache
+    [key1 setObject:@"changed" forKey:@"data"];
+    [key1 setObject:@"moky" forKey:@"sender"];
+    MKTestSessionKey *key3 = MKSymmetricKeyParse(info);
+    XCTAssertEqualObjects([key3 objectForKey:@"data"], @"secret");
+    XCTAssertNil([key3 objectForKey:@"sender"]);
+}
+
+- (void)testNotCachedWhenParseFails {
+    MKCryptoExtensions *ext = [MKCryptoExtensions sharedInstance];
+    XCTAssertNil(MKSymmetricKeyParse(@{@"data": @"secret"}));
+    XCTAssertNil(MKSymmetricKeyParse(@{@"data": @"secret"}));
+    XCTAssertEqual(self.helper.parseCount, 2);
+    XCTAssertEqual(ext.symmetricKeyCache.count, 0);
+}
+
+- (void)testCopyOwnsDictionary {
+    MKTestSessionKey *key = [[MKTestSessionKey alloc] initWithDictionary:@{
+        @"algorithm": @"AES", @"data": @"secret",
+    }];
+    MKTestSessionKey *copied = [key copy];
+    [copied setObject:@"changed" forKey:@"data"];
+    XCTAssertEqualObjects([key objectForKey:@"data"], @"secret");
+    XCTAssertEqualObjects([copied objectForKey:@"data"], @"changed");
+}
+
+@end
@@ -0,0 +1,262 @@
+//
+//  MKSymmetricKeyTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Format.h>
+#import <MingKeMing/Crypto.h>
+
+#import "MKMallocCounter.h"
+
+@interface MKTestSymmetricBase64 : NSObject <MKDataCoder>
+
+@end
+
+@implementation MKTestSymmetricBase64
+
+- (NSString *)encode:(NSData *)data {
+    return [data base64EncodedStringWithOptions:0];
+}
+
+- (nullable NSData *)decode:(NSString *)string {
+    return [[NSData alloc] initWithBase64EncodedString:string options:0];
+}
+
+@end
+
+// AES key with the dictionary methods only
+@interface MKTestDictionaryKey : MKDictionary <MKSymmetricKey>
+
+@property (strong, nonatomic) NSData *data;
+
+@end
+
+@implementation MKTestDictionaryKey
+
+- (NSString *)algorithm {
+    return @"AES";
+}
+
+- (NSData *)encrypt:(NSData *)plaintext extra:(nullable NSMutableDictionary *)params {
+    MKAESStream *cipher = [MKAESStream encryptStreamWithKey:self.data params:params];
+    NSMutableData *out = [[NSMutableData alloc] initWithData:[cipher update:plaintext]];
+    [out appendData:[cipher finish]];
+    return out;
+}
+
+- (nullable NSData *)decrypt:(NSData *)ciphertext params:(nullable NSDictionary *)extra {
+    MKAESStream *cipher = [MKAESStream decryptStreamWithKey:self.data params:(extra ? extra : @{})];
+    NSMutableData *out = [[NSMutableData alloc] initWithData:[cipher update:ciphertext]];
+    NSData *last = [cipher finish];
+    if (!last) {
+        return nil;
+    }
+    [out appendData:last];
+    return out;
+}
+
+- (BOOL)matchEncryptKey:(id<MKEncryptKey>)pKey {
+    return [pKey.data isEqualToData:self.data];
+}
+
+- (nullable id<MKCipherStream>)encryptStream:(nullable NSMutableDictionary *)params {
+    return [MKAESStream encryptStreamWithKey:self.data params:params];
+}
+
+- (nullable id<MKCipherStream>)decryptStream:(nullable NSDictionary *)extra {
+    return [MKAESStream decryptStreamWithKey:self.data params:(extra ? extra : @{})];
+}
+
+@end
+
+// same key, with the buffer methods
+@interface MKTestBufferKey : MKTestDictionaryKey
+
+@end
+
+@implementation MKTestBufferKey
+
+- (NSInteger)encrypt:(const void *)plaintext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(MKCipherParams *)params {
+    NSData *pwd = self.data;
+    return MKAESEncryptInto(pwd.bytes, pwd.length, plaintext, length, output, capacity, params);
+}
+
+- (NSInteger)decrypt:(const void *)ciphertext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(const MKCipherParams *)params {
+    NSData *pwd = self.data;
+    return MKAESDecryptInto(pwd.bytes, pwd.length, ciphertext, length, output, capacity, params);
+}
+
+@end
+
+// same key, with a prepared context
+@interface MKTestContextKey : MKTestDictionaryKey
+
+@property (strong, nonatomic) MKAESContext *context;
+
+@end
+
+@implementation MKTestContextKey
+
+- (void)prepare {
+    self.context = [[MKAESContext alloc] initWithKey:self.data];
+}
+
+- (NSInteger)encrypt:(const void *)plaintext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(MKCipherParams *)params {
+    return [self.context encrypt:plaintext length:length output:output capacity:capacity params:params];
+}
+
+- (NSInteger)decrypt:(const void *)ciphertext length:(NSUInteger)length
+              output:(void *)output capacity:(NSUInteger)capacity
+              params:(const MKCipherParams *)params {
+    return [self.context decrypt:ciphertext length:length output:output capacity:capacity params:params];
+}
+
+@end
+
+// IV too long for MKCipherParams
+@interface MKTestLongIVKey : MKTestDictionaryKey
+
+@end
+
+@implementation MKTestLongIVKey
+
+- (NSData *)encrypt:(NSData *)plaintext extra:(nullable NSMutableDictionary *)params {
+    NSData *ciphertext = [super encrypt:plaintext extra:params];
+    NSMutableData *iv = [[NSMutableData alloc] initWithLength:32];
+    [params setObject:MKBase64Encode(iv) forKey:@"IV"];
+    return ciphertext;
+}
+
+@end
+
+@interface MKSymmetricKeyTests : XCTestCase
+
+@end
+
+@implementation MKSymmetricKeyTests
+
+- (void)setUp {
+    [MKBase64 setCoder:[[MKTestSymmetricBase64 alloc] init]];
+}
+
+static id new_key(Class clazz, NSData *pwd) {
+    MKTestDictionaryKey *key = [[clazz alloc] init];
+    key.data = pwd;
+    return key;
+}
+
+static NSData *random_data(NSUInteger length) {
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:length];
+    arc4random_buf(data.mutableBytes, length);
+    return data;
+}
+
+- (void)testBufferAndDictionaryPathsAgree {
+    NSData *pwd = random_data(32);
+    id<MKSymmetricKey> dictKey = new_key([MKTestDictionaryKey class], pwd);
+    id<MKSymmetricKey> bufferKey = new_key([MKTestBufferKey class], pwd);
+    NSData *plaintext = random_data(1000);
+    NSMutableData *buffer = [[NSMutableData alloc] initWithLength:plaintext.length];
+    MKCipherParams params;
+    // encrypted through the dictionary fallback
+    NSInteger len = MKSymmetricKeyEncryptInto(dictKey, plaintext.bytes, plaintext.length,
+                                              buffer.mutableBytes, buffer.length, &params);
+    XCTAssertEqual(len, plaintext.length);
+    XCTAssertEqual(params.ivLength, 16);
+    XCTAssertEqual(params.tagLength, 32);
+    // decrypted in place by the buffer methods
+    len = MKSymmetricKeyDecryptInto(bufferKey, buffer.bytes, buffer.length,
+                                    buffer.mutableBytes, buffer.length, &params);
+    XCTAssertEqual(len, plaintext.length);
+    XCTAssertEqualObjects(buffer, plaintext);
+    // and back the other way
+    len = MKSymmetricKeyEncryptInto(bufferKey, buffer.bytes, buffer.length,
+                                    buffer.mutableBytes, buffer.length, &params);
+    len = MKSymmetricKeyDecryptInto(dictKey, buffer.bytes, buffer.length,
+                                    buffer.mutableBytes, buffer.length, &params);
+    XCTAssertEqual(len, plaintext.length);
+    XCTAssertEqualObjects(buffer, plaintext);
+}
+
+- (void)testFallbackChecksCapacity {
+    id<MKSymmetricKey> key = new_key([MKTestDictionaryKey class], random_data(16));
+    NSData *plaintext = random_data(100);
+    UInt8 output[64];
+    MKCipherParams params;
+    XCTAssertEqual(MKSymmetricKeyEncryptInto(key, plaintext.bytes, plaintext.length,
+                                             output, sizeof(output), &params), -1);
+}
+
+- (void)testFallbackRejectsLongParams {
+    id<MKSymmetricKey> key = new_key([MKTestLongIVKey class], random_data(16));
+    NSData *plaintext = random_data(100);
+    UInt8 output[100];
+    MKCipherParams params;
+    XCTAssertEqual(MKSymmetricKeyEncryptInto(key, plaintext.bytes, plaintext.length,
+                                             output, sizeof(output), &params), -1);
+}
+
+- (void)testPreparedContextWithoutAllocation {
+    MKTestContextKey *key = new_key([MKTestContextKey class], random_data(32));
+    [key prepare];
+    NSData *plaintext = random_data(512);
+    NSMutableData *buffer = [plaintext mutableCopy];
+    UInt8 *bytes = buffer.mutableBytes;
+    NSUInteger length = buffer.length;
+    __block MKCipherParams params;
+    // first call expands a cryptor for the pool
+    MKSymmetricKeyEncryptInto(key, bytes, length, bytes, length, &params);
+    MKSymmetricKeyDecryptInto(key, bytes, length, bytes, length, &params);
+    NSUInteger count = MKCountMallocs(^{
+        for (NSUInteger i = 0; i < 1000; ++i) {
+            MKSymmetricKeyEncryptInto(key, bytes, length, bytes, length, &params);
+            MKSymmetricKeyDecryptInto(key, bytes, length, bytes, length, &params);
+        }
+    });
+    // none per message in steady state
+    XCTAssertLessThan(count, 10);
+    XCTAssertEqualObjects(buffer, plaintext);
+}
+
+// many small messages, as a chat session does
+static void encrypt_messages(id<MKSymmetricKey> key, NSMutableData *buffer, NSUInteger count) {
+    MKCipherParams params;
+    for (NSUInteger i = 0; i < count; ++i) {
+        @autoreleasepool {
+            MKSymmetricKeyEncryptInto(key, buffer.bytes, buffer.length,
+                                      buffer.mutableBytes, buffer.length, &params);
+            MKSymmetricKeyDecryptInto(key, buffer.bytes, buffer.length,
+                                      buffer.mutableBytes, buffer.length, &params);
+        }
+    }
+}
+
+- (void)testBufferPathPerformance {
+    id<MKSymmetricKey> key = new_key([MKTestBufferKey class], random_data(32));
+    NSMutableData *buffer = [random_data(512) mutableCopy];
+    [self measureBlock:^{
+        encrypt_messages(key, buffer, 2000);
+    }];
+}
+
+- (void)testDictionaryPathPerformance {
+    id<MKSymmetricKey> key = new_key([MKTestDictionaryKey class], random_data(32));
+    NSMutableData *buffer = [random_data(512) mutableCopy];
+    [self measureBlock:^{
+        encrypt_messages(key, buffer, 2000);
+    }];
+}
+
+@end
@@ -0,0 +1,257 @@
+//
+//  MKTransportableDataTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Format.h>
+#import <MingKeMing/Ext.h>
+
+// Base-64 coder counting its calls
+@interface MKTestBase64Coder : NSObject <MKDataCoder>
+
+@property (nonatomic) NSUInteger encodeCount;
+@property (nonatomic) NSUInteger decodeCount;
+
+@end
+
+@implementation MKTestBase64Coder
+
+- (NSString *)encode:(NSData *)data {
+    @synchronized (self) {
+        _encodeCount += 1;
+    }
+    return [data base64EncodedStringWithOptions:0];
+}
+
+- (nullable NSData *)decode:(NSString *)string {
+    @synchronized (self) {
+        _decodeCount += 1;
+    }
+    return [[NSData alloc] initWithBase64EncodedString:string options:0];
+}
+
+@end
+
+// parses strings only, tagged to tell helpers apart
+@interface MKTestTEDHelper : NSObject <MKTransportableDataHelper>
+
+@property (strong, nonatomic) NSString *tag;
+
+@end
+
+@implementation MKTestTEDHelper
+
+- (void)setTransportableDataFactory:(id<MKTransportableDataFactory>)factory
+                          algorithm:(NSString *)name {
+}
+
+- (nullable id<MKTransportableDataFactory>)getTransportableDataFactory:(NSString *)algorithm {
+    return nil;
+}
+
+- (id<MKTransportableData>)createTransportableData:(NSData *)data
+                                         algorithm:(nullable NSString *)name {
+    return [[MKTransportableData alloc] initWithData:data algorithm:name];
+}
+
+- (nullable id<MKTransportableData>)parseTransportableData:(nullable id)ted {
+    if (![ted isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+    MKTransportableData *res = [[MKTransportableData alloc] initWithString:ted];
+    [res setObject:self.tag forKey:@"helper"];
+    return res;
+}
+
+@end
+
+@interface MKTransportableDataTests : XCTestCase
+
+@property (strong, nonatomic) MKTestBase64Coder *coder;
+
+@end
+
+@implementation MKTransportableDataTests
+
+- (void)setUp {
+    self.coder = [[MKTestBase64Coder alloc] init];
+    [MKBase64 setCoder:self.coder];
+}
+
+static NSData *random_data(NSUInteger length) {
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:length];
+    arc4random_buf(data.mutableBytes, length);
+    return data;
+}
+
+static NSString *write_to_memory(MKTransportableData *ted) {
+    NSOutputStream *sink = [NSOutputStream outputStreamToMemory];
+    [sink open];
+    BOOL ok = [ted writeToStream:sink];
+    NSData *out = [sink propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+    [sink close];
+    return ok ? [[NSString alloc] initWithData:out encoding:NSUTF8StringEncoding] : nil;
+}
+
+- (void)testParseString {
+    NSData *data = random_data(100);
+    NSString *encoded = [data base64EncodedStringWithOptions:0];
+    NSString *text = [@"data:image/png;base64," stringByAppendingString:encoded];
+    MKTransportableData *ted = [[MKTransportableData alloc] initWithString:text];
+    XCTAssertEqualObjects(ted.algorithm, @"base64");
+    XCTAssertEqual(ted.algorithmTag, MKTypeTag_Base64);
+    XCTAssertEqualObjects(ted.data, data);
+    // the original string is re-emitted
+    XCTAssertEqualObjects(ted.string, text);
+}
+
+- (void)testLargeDataDecodedOnce {
+    // larger than any shared cache limit
+    NSData *data = random_data(24 * 1024 * 1024);
+    NSString *encoded = [data base64EncodedStringWithOptions:0];
+    MKTransportableData *ted = [[MKTransportableData alloc] initWithString:encoded];
+    XCTAssertEqualObjects(ted.data, data);
+    XCTAssertEqualObjects(ted.data, data);
+    XCTAssertEqual(self.coder.decodeCount, 1);
+}
+
+- (void)testChunkedWriteUsesCoder {
+    // a few chunks, not a multiple of 3
+    NSData *data = random_data(3 * 16 * 1024 * 3 + 2);
+    MKTransportableData *ted = [[MKTransportableData alloc] initWithData:data algorithm:@"base64"];
+    NSString *out = write_to_memory(ted);
+    XCTAssertEqualObjects(out, [@"base64," stringByAppendingString:[data base64EncodedStringWithOptions:0]]);
+    XCTAssertEqual(self.coder.encodeCount, 4);
+    // same as the memoized string
+    XCTAssertEqualObjects(ted.string, out);
+}
+
+- (void)testConcurrentReads {
+    NSData *data = random_data(4096);
+    MKTransportableData *ted = [[MKTransportableData alloc] initWithData:data algorithm:@"base64"];
+    NSString *expected = [@"base64," stringByAppendingString:[data base64EncodedStringWithOptions:0]];
+    dispatch_apply(256, DISPATCH_APPLY_AUTO, ^(size_t iteration) {
+        XCTAssertEqualObjects(ted.string, expected);
+        XCTAssertEqualObjects([ted objectForKey:@"data"], [data base64EncodedStringWithOptions:0]);
+        XCTAssertEqual(ted.algorithmTag, MKTypeTag_Base64);
+    });
+    // getters never touch the inner dictionary
+    MKTransportableData *parsed = [[MKTransportableData alloc] initWithString:expected];
+    dispatch_apply(256, DISPATCH_APPLY_AUTO, ^(size_t iteration) {
+        XCTAssertEqualObjects(parsed.data, data);
+    });
+}
+
+- (void)testChangeAlgorithmKeepsBody {
+    NSData *data = random_data(30);
+    MKTransportableData *ted = [[MKTransportableData alloc] initWithData:data algorithm:@"base64"];
+    NSString *body = [ted objectForKey:@"data"];
+    XCTAssertEqualObjects([ted.dictionary objectForKey:@"data"], body);
+    [ted setObject:@"hex" forKey:@"algorithm"];
+    XCTAssertEqual(ted.algorithmTag, MKTypeTag_Hex);
+    XCTAssertEqualObjects([ted objectForKey:@"data"], body);
+}
+
+- (void)testUnknownAlgorithm {
+    // from a remote peer, no assertion
+    MKTransportableData *ted = [[MKTransportableData alloc] initWithString:@"base32,MFRGG==="];
+    XCTAssertEqual(ted.algorithmTag, MKTypeTag_Unknown);
+    XCTAssertNil(ted.data);
+    XCTAssertEqualObjects(ted.string, @"base32,MFRGG===");
+    ted = [[MKTransportableData alloc] initWithData:random_data(8) algorithm:@"base32"];
+    XCTAssertNil([ted objectForKey:@"data"]);
+    XCTAssertEqualObjects(ted.string, @"");
+    XCTAssertNil([ted.dictionary objectForKey:@"data"]);
+}
+
+- (void)testBigDataReclaimable {
+    NSData *data = random_data(256 * 1024);
+    NSString *encoded = [data base64EncodedStringWithOptions:0];
+    MKTransportableData *ted = [[MKTransportableData alloc] initWithString:encoded];
+    NSPurgeableData *purgeable;
+    @autoreleasepool {
+        NSData *first = ted.data;
+        NSData *second = ted.data;
+        XCTAssertEqualObjects(first, data);
+        // same bytes, not copied for each caller
+        XCTAssertEqual(first.bytes, second.bytes);
+        purgeable = [[ted valueForKey:@"memo"] valueForKey:@"decoded"];
+        XCTAssertTrue([purgeable isKindOfClass:[NSPurgeableData class]]);
+        // in use, cannot be dropped
+        [purgeable discardContentIfPossible];
+        XCTAssertFalse([purgeable isContentDiscarded]);
+    }
+    XCTAssertEqual(self.coder.decodeCount, 1);
+    // no caller holds it, as under memory pressure
+    [purgeable discardContentIfPossible];
+    XCTAssertTrue([purgeable isContentDiscarded]);
+    XCTAssertEqualObjects(ted.data, data);
+    XCTAssertEqual(self.coder.decodeCount, 2);
+}
+
+- (void)testDictionaryIsInnerMap {
+    NSData *data = random_data(30);
+    MKTransportableData *ted = [[MKTransportableData alloc] initWithData:data algorithm:@"base64"];
+    NSMutableDictionary *inner = ted.dictionary;
+    // encoded body stored once
+    XCTAssertEqualObjects([inner objectForKey:@"data"], [data base64EncodedStringWithOptions:0]);
+    XCTAssertEqual(ted.dictionary, inner);
+    // writes are not lost
+    [inner setObject:@"avatar.png" forKey:@"filename"];
+    XCTAssertEqualObjects([ted objectForKey:@"filename"], @"avatar.png");
+    XCTAssertEqualObjects(ted.data, data);
+}
+
+- (void)testCopyOwnsDictionary {
+    NSData *data = random_data(30);
+    NSString *encoded = [@"base64," stringByAppendingString:[data base64EncodedStringWithOptions:0]];
+    MKTransportableData *ted = [[MKTransportableData alloc] initWithString:encoded];
+    MKTransportableData *copy = [ted copy];
+    XCTAssertEqualObjects(copy.string, encoded);
+    [copy setObject:@"hex" forKey:@"algorithm"];
+    [copy.dictionary setObject:@"x" forKey:@"extra"];
+    XCTAssertEqualObjects(ted.algorithm, @"base64");
+    XCTAssertNil([ted objectForKey:@"extra"]);
+    XCTAssertEqualObjects(ted.string, encoded);
+    XCTAssertEqualObjects(ted.data, data);
+}
+
+- (void)testParseCacheHandsOutCopies {
+    MKFormatExtensions *ext = [MKFormatExtensions sharedInstance];
+    id<MKTransportableDataHelper> helper = ext.tedHelper;
+    MKLRUCache *cache = ext.tedCache;
+    MKTestTEDHelper *first = [[MKTestTEDHelper alloc] init];
+    first.tag = @"first";
+    ext.tedHelper = first;
+    ext.tedCache = [[MKLRUCache alloc] initWithCountLimit:16];
+
+    NSData *data = random_data(30);
+    NSString *encoded = [@"base64," stringByAppendingString:[data base64EncodedStringWithOptions:0]];
+    id<MKTransportableData> one = MKTransportableDataParse(encoded);
+    id<MKTransportableData> two = MKTransportableDataParse(encoded);
+    XCTAssertNotEqual(one, two);
+    [one.dictionary setObject:@"changed" forKey:@"helper"];
+    XCTAssertEqualObjects([two objectForKey:@"helper"], @"first");
+    XCTAssertEqualObjects([MKTransportableDataParse(encoded) objectForKey:@"helper"], @"first");
+    // copies share what is decoded
+    XCTAssertEqualObjects(one.data, data);
+    XCTAssertEqualObjects(two.data, data);
+    XCTAssertEqual(self.coder.decodeCount, 1);
+
+    // entries of the old helper are dropped
+    MKTestTEDHelper *second = [[MKTestTEDHelper alloc] init];
+    second.tag = @"second";
+    ext.tedHelper = second;
+    XCTAssertEqualObjects([MKTransportableDataParse(encoded) objectForKey:@"helper"], @"second");
+
+    ext.tedHelper = helper;
+    ext.tedCache = cache;
+}
+
+@end
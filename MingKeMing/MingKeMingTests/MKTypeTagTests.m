@@ -0,0 +1,43 @@
+//
+//  MKTypeTagTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+
+@interface MKTypeTagTests : XCTestCase
+
+@end
+
+@implementation MKTypeTagTests
+
+- (void)testKnownNames {
+    for (MKTypeTag tag = MKTypeTag_Base64; tag < MKTypeTagCount; ++tag) {
+        NSString *name = MKTypeTagToString(tag);
+        XCTAssertNotNil(name);
+        XCTAssertEqual(MKTypeTagFromString(name), tag);
+    }
+    XCTAssertNil(MKTypeTagToString(MKTypeTag_Unknown));
+}
+
+- (void)testCaseSensitive {
+    XCTAssertEqual(MKTypeTagFromString(@"base64"), MKTypeTag_Base64);
+    XCTAssertEqual(MKTypeTagFromString(@"BASE64"), MKTypeTag_Unknown);
+    XCTAssertEqual(MKTypeTagFromString(@"Hex"), MKTypeTag_Unknown);
+}
+
+- (void)testUnknownNames {
+    XCTAssertEqual(MKTypeTagFromString(nil), MKTypeTag_Unknown);
+    XCTAssertEqual(MKTypeTagFromString(@""), MKTypeTag_Unknown);
+    XCTAssertEqual(MKTypeTagFromString(@"base64url"), MKTypeTag_Unknown);
+    XCTAssertEqual(MKTypeTagFromString(@"hex\0"), MKTypeTag_Unknown);
+    XCTAssertEqual(MKTypeTagFromString(@"hé"), MKTypeTag_Unknown);
+    XCTAssertEqual(MKTypeTagFromString(@"RSA"), MKTypeTag_Unknown);
+}
+
+@end
@@ -0,0 +1,63 @@
+//
+//  MKUTF8Tests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Format.h>
+
+@interface MKUTF8Tests : XCTestCase
+
+@property (strong, nonatomic) MKUTF8Coder *coder;
+
+@end
+
+@implementation MKUTF8Tests
+
+- (void)setUp {
+    self.coder = [[MKUTF8Coder alloc] init];
+}
+
+static NSData *bytes(const char *str) {
+    return [[NSData alloc] initWithBytes:str length:strlen(str)];
+}
+
+- (void)testRoundTrip {
+    NSArray *samples = @[@"", @"moky@anywhere", @"名可名，非常名", @"mix 中文 and emoji 😀 end"];
+    for (NSString *text in samples) {
+        NSData *utf8 = [self.coder encode:text];
+        XCTAssertEqualObjects(utf8, [text dataUsingEncoding:NSUTF8StringEncoding]);
+        XCTAssertEqualObjects([self.coder decode:utf8], text);
+    }
+}
+
+- (void)testLongText {
+    NSMutableString *text = [[NSMutableString alloc] init];
+    for (NSUInteger i = 0; i < 1000; ++i) {
+        [text appendString:(i % 7 ? @"abcdefgh" : @"名")];
+    }
+    NSData *utf8 = [self.coder encode:text];
+    XCTAssertEqualObjects([self.coder decode:utf8], text);
+}
+
+- (void)testRejectInvalidBytes {
+    XCTAssertNil([self.coder decode:bytes("abc\xC0\xAF")]);          // overlong
+    XCTAssertNil([self.coder decode:bytes("\xED\xA0\x80")]);         // surrogate
+    XCTAssertNil([self.coder decode:bytes("\xF4\x90\x80\x80")]);     // > U+10FFFF
+    XCTAssertNil([self.coder decode:bytes("truncated \xE4\xB8")]);
+    XCTAssertNil([self.coder decode:bytes("\x80")]);
+}
+
+- (void)testUnpairedSurrogate {
+    unichar chars[] = {'a', 0xD800, 'b', 0x4E2D};
+    NSString *bad = [NSString stringWithCharacters:chars length:4];
+    NSData *utf8 = [self.coder encode:bad];
+    // not truncated at the bad char
+    XCTAssertEqualObjects(utf8, bytes("a?b\xE4\xB8\xAD"));
+}
+
+@end
@@ -0,0 +1,286 @@
+//
+//  MKVerifyBatchTests.m
+//  MingKeMingTests
+//
+//  Created by agent on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <MingKeMing/Type.h>
+#import <MingKeMing/Crypto.h>
+
+// signature = data + key data
+@interface MKTestVerifyKey : MKDictionary <MKVerifyKey>
+
+@property (strong, nonatomic) NSString *algorithm;
+@property (strong, nonatomic) NSData *data;
+
+@end
+
+@implementation MKTestVerifyKey
+
+- (NSData *)sign:(NSData *)data {
+    NSMutableData *signature = [[NSMutableData alloc] initWithData:data];
+    [signature appendData:self.data];
+    return signature;
+}
+
+- (BOOL)verify:(NSData *)data withSignature:(NSData *)signature {
+    return [[self sign:data] isEqualToData:signature];
+}
+
+- (BOOL)matchSignKey:(id<MKSignKey>)sKey {
+    return NO;
+}
+
+@end
+
+// with its own batch verification
+@interface MKTestBatchVerifyKey : MKTestVerifyKey
+
+@property (nonatomic) NSUInteger batchCount;
+
+@end
+
+@implementation MKTestBatchVerifyKey
+
+- (NSIndexSet *)verifyBatch:(NSArray<NSData *> *)messages
+             withSignatures:(NSArray<NSData *> *)signatures {
+    _batchCount += 1;
+    NSMutableIndexSet *valid = [[NSMutableIndexSet alloc] init];
+    for (NSUInteger index = 0; index < messages.count; ++index) {
+        if ([self verify:messages[index] withSignature:signatures[index]]) {
+            [valid addIndex:index];
+        }
+    }
+    return valid;
+}
+
+@end
+
+// fails verifying unless prepared
+@interface MKTestPreparedKey : MKTestVerifyKey
+
+@property (readonly) NSUInteger prepareCount;
+@property (readonly) NSUInteger unprepareCount;
+@property (readonly) BOOL prepared;
+
+@end
+
+@implementation MKTestPreparedKey
+
+- (void)prepare {
+    @synchronized (self) {
+        NSAssert(!_prepared, @"prepared twice");
+        _prepared = YES;
+        _prepareCount += 1;
+    }
+}
+
+- (void)unprepare {
+    @synchronized (self) {
+        _prepared = NO;
+        _unprepareCount += 1;
+    }
+}
+
+- (BOOL)verify:(NSData *)data withSignature:(NSData *)signature {
+    @synchronized (self) {
+        if (!_prepared) {
+            return NO;
+        }
+    }
+    return [super verify:data withSignature:signature];
+}
+
+@end
+
+// slow to prepare
+@interface MKTestSlowPreparedKey : MKTestPreparedKey
+
+@property (strong, nonatomic, nullable) dispatch_semaphore_t started;
+@property (strong, nonatomic, nullable) dispatch_semaphore_t gate;
+@property (nonatomic) useconds_t delay;
+
+@end
+
+@implementation MKTestSlowPreparedKey
+
+- (void)prepare {
+    if (self.started) {
+        dispatch_semaphore_signal(self.started);
+    }
+    if (self.gate) {
+        dispatch_semaphore_wait(self.gate, DISPATCH_TIME_FOREVER);
+    }
+    if (self.delay > 0) {
+        usleep(self.delay);
+    }
+    [super prepare];
+}
+
+@end
+
+@interface MKVerifyBatchTests : XCTestCase
+
+@end
+
+@implementation MKVerifyBatchTests
+
+static id new_key(Class clazz) {
+    MKTestVerifyKey *key = [[clazz alloc] init];
+    key.algorithm = @"TEST";
+    key.data = [@"secret" dataUsingEncoding:NSUTF8StringEncoding];
+    return key;
+}
+
+// every third signature is broken
+static void make_batch(MKTestVerifyKey *key, NSUInteger count,
+                       NSMutableArray *messages, NSMutableArray *signatures) {
+    for (NSUInteger index = 0; index < count; ++index) {
+        NSData *data = [[NSString stringWithFormat:@"msg-%lu", index] dataUsingEncoding:NSUTF8StringEncoding];
+        [messages addObject:data];
+        [signatures addObject:(index % 3 ? [key sign:data] : data)];
+    }
+}
+
+- (void)testValidIndexes {
+    MKTestVerifyKey *key = new_key([MKTestVerifyKey class]);
+    NSMutableArray *messages = [[NSMutableArray alloc] init];
+    NSMutableArray *signatures = [[NSMutableArray alloc] init];
+    make_batch(key, 30, messages, signatures);
+    NSIndexSet *valid = MKVerifyBatch(key, messages, signatures);
+    XCTAssertEqual(valid.count, 20);
+    XCTAssertFalse([valid containsIndex:0]);
+    XCTAssertTrue([valid containsIndex:1]);
+    XCTAssertEqualObjects(MKVerifyBatchConcurrently(key, messages, signatures), valid);
+}
+
+- (void)tearDown {
+    MKVerifyKeyUnprepareAll();
+}
+
+- (void)testLeaseOutlivesRegistry {
+    MKTestPreparedKey *key = new_key([MKTestPreparedKey class]);
+    id lease = MKVerifyKeyPrepare(key);
+    XCTAssertNotNil(lease);
+    XCTAssertTrue(key.prepared);
+    // prepared once
+    id lease2 = MKVerifyKeyPrepare(key);
+    XCTAssertEqual(key.prepareCount, 1);
+    lease2 = nil;
+    // dropped from registry, still leased
+    MKVerifyKeyUnprepareAll();
+    XCTAssertTrue(key.prepared);
+    lease = nil;
+    XCTAssertFalse(key.prepared);
+    XCTAssertEqual(key.unprepareCount, 1);
+    // no lease for keys without 'prepare'
+    XCTAssertNil(MKVerifyKeyPrepare(new_key([MKTestVerifyKey class])));
+}
+
+- (void)testEvictionKeepsLeasedKey {
+    MKTestPreparedKey *first = new_key([MKTestPreparedKey class]);
+    id lease = MKVerifyKeyPrepare(first);
+    NSMutableArray *others = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < 100; ++i) {
+        MKTestPreparedKey *key = new_key([MKTestPreparedKey class]);
+        [others addObject:key];
+        @autoreleasepool {
+            MKVerifyKeyPrepare(key);
+        }
+    }
+    // evicted, but in use
+    XCTAssertTrue(first.prepared);
+    XCTAssertEqual(first.unprepareCount, 0);
+    XCTAssertFalse([others.firstObject prepared]);
+    XCTAssertTrue([others.lastObject prepared]);
+    lease = nil;
+    XCTAssertFalse(first.prepared);
+}
+
+- (void)testConcurrentVerifyWhileEvicting {
+    // more keys than the registry holds
+    NSMutableArray *keys = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < 100; ++i) {
+        [keys addObject:new_key([MKTestPreparedKey class])];
+    }
+    NSMutableArray *messages = [[NSMutableArray alloc] init];
+    NSMutableArray *signatures = [[NSMutableArray alloc] init];
+    make_batch(keys.firstObject, 12, messages, signatures);
+    dispatch_apply(1000, DISPATCH_APPLY_AUTO, ^(size_t iteration) {
+        MKTestPreparedKey *key = keys[iteration % keys.count];
+        // never unprepared under a running batch
+        XCTAssertEqual(MKVerifyBatch(key, messages, signatures).count, 8);
+    });
+    for (MKTestPreparedKey *key in keys) {
+        XCTAssertLessThanOrEqual(key.unprepareCount, key.prepareCount);
+    }
+}
+
+- (void)testCountMismatch {
+    MKTestBatchVerifyKey *key = new_key([MKTestBatchVerifyKey class]);
+    NSMutableArray *messages = [[NSMutableArray alloc] init];
+    NSMutableArray *signatures = [[NSMutableArray alloc] init];
+    make_batch(key, 30, messages, signatures);
+    [signatures removeLastObject];
+    XCTAssertEqual(MKVerifyBatch(key, messages, signatures).count, 0);
+    XCTAssertEqual(MKVerifyBatchConcurrently(key, messages, signatures).count, 0);
+    XCTAssertEqual(MKVerifyBatch(new_key([MKTestVerifyKey class]), messages, signatures).count, 0);
+    // never handed to the key
+    XCTAssertEqual(key.batchCount, 0);
+}
+
+- (void)testPrepareOutsideRegistryLock {
+    MKTestSlowPreparedKey *slow = new_key([MKTestSlowPreparedKey class]);
+    slow.started = dispatch_semaphore_create(0);
+    slow.gate = dispatch_semaphore_create(0);
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, queue, ^{
+        NS_VALID_UNTIL_END_OF_SCOPE id lease = MKVerifyKeyPrepare(slow);
+        XCTAssertTrue(slow.prepared);
+    });
+    dispatch_semaphore_wait(slow.started, DISPATCH_TIME_FOREVER);
+    // another key is not blocked by the slow one
+    dispatch_semaphore_t other = dispatch_semaphore_create(0);
+    dispatch_async(queue, ^{
+        MKTestPreparedKey *key = new_key([MKTestPreparedKey class]);
+        NS_VALID_UNTIL_END_OF_SCOPE id lease = MKVerifyKeyPrepare(key);
+        XCTAssertTrue(key.prepared);
+        dispatch_semaphore_signal(other);
+    });
+    XCTAssertEqual(dispatch_semaphore_wait(other, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), 0);
+    // the same key waits until prepared
+    dispatch_semaphore_t waiter = dispatch_semaphore_create(0);
+    dispatch_group_async(group, queue, ^{
+        NS_VALID_UNTIL_END_OF_SCOPE id lease = MKVerifyKeyPrepare(slow);
+        XCTAssertTrue(slow.prepared);
+        dispatch_semaphore_signal(waiter);
+    });
+    XCTAssertNotEqual(dispatch_semaphore_wait(waiter, dispatch_time(DISPATCH_TIME_NOW, 100 * NSEC_PER_MSEC)), 0);
+    dispatch_semaphore_signal(slow.gate);
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    XCTAssertEqual(slow.prepareCount, 1);
+    MKVerifyKeyUnprepareAll();
+}
+
+// many threads preparing different keys, as for a group chat
+- (void)testPrepareThroughput {
+    [self measureBlock:^{
+        NSMutableArray *keys = [[NSMutableArray alloc] initWithCapacity:64];
+        for (NSUInteger i = 0; i < 64; ++i) {
+            MKTestSlowPreparedKey *key = new_key([MKTestSlowPreparedKey class]);
+            key.delay = 2000;
+            [keys addObject:key];
+        }
+        dispatch_apply(keys.count, DISPATCH_APPLY_AUTO, ^(size_t index) {
+            NS_VALID_UNTIL_END_OF_SCOPE id lease = MKVerifyKeyPrepare(keys[index]);
+        });
+        MKVerifyKeyUnprepareAll();
+    }];
+}
+
+@end